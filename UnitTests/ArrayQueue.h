@@ -0,0 +1,483 @@
+#ifndef ARRAY_QUEUE_H
+#define ARRAY_QUEUE_H
+
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "SpanKernels.h"
+
+static const std::size_t MINIMAL_ARRAY_CAPACITY = 8;
+
+/**
+ * @brief: ArrayQueue class, a queue with the same interface as Queue, stored in a growable circular buffer
+ * @tparam T: type of the items in the queue
+ *
+ * @note: the items live contiguously (up to one wrap around), pushBack is amortized O(1) and never allocates
+ *        per item, and the iterators are random access so the standard algorithms work on the queue
+ */
+template<class T>
+class ArrayQueue {
+private:
+    T* m_items;
+    std::size_t m_capacity;
+    std::size_t m_head;
+    std::size_t m_size;
+
+    /**
+     * @param: index of an item, counted from the front of the queue
+     * @return: the position of the item in the buffer
+     */
+    std::size_t physicalIndex(std::size_t index) const {
+        std::size_t position = m_head + index;
+        return (position >= m_capacity) ? position - m_capacity : position;
+    }
+
+    T& itemAt(std::size_t index) {
+        return m_items[physicalIndex(index)];
+    }
+
+    const T& itemAt(std::size_t index) const {
+        return m_items[physicalIndex(index)];
+    }
+
+    /**
+     * @description: moves the items into a new buffer of the given capacity, starting at its beginning
+     * @param: newCapacity - at least the size of the queue
+     * @note: items are copied instead of moved when their move may throw, so on failure the queue is unchanged
+     */
+    void reallocate(std::size_t newCapacity) {
+        if (newCapacity > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        T* newItems = (newCapacity == 0) ? nullptr : static_cast<T*>(::operator new(sizeof(T) * newCapacity));
+        std::size_t constructed = 0;
+        try {
+            for (; constructed < m_size; ++constructed) {
+                new (newItems + constructed) T(std::move_if_noexcept(itemAt(constructed)));
+            }
+        }
+        catch (...) {
+            destroyItems(newItems, 0, constructed);
+            ::operator delete(newItems);
+            throw;
+        }
+        destroyAll();
+        ::operator delete(m_items);
+        m_items = newItems;
+        m_capacity = newCapacity;
+        m_head = 0;
+    }
+
+    static void destroyItems(T* items, std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            items[i].~T();
+        }
+    }
+
+    void destroyAll() {
+        for (std::size_t i = 0; i < m_size; ++i) {
+            itemAt(i).~T();
+        }
+    }
+
+    /**
+     * @description: constructs a new item after the last item, doubling the buffer if it is full
+     * @param: arguments forwarded to the constructor of the item
+     * @note: if the growth or the construction throws, the queue is left unchanged
+     */
+    template<class... Args>
+    void emplaceItem(Args&&... args) {
+        if (m_size == m_capacity) {
+            // The item is built before growing, since the arguments may refer to an item of the queue
+            T item(std::forward<Args>(args)...);
+            reallocate(m_capacity < MINIMAL_ARRAY_CAPACITY ? MINIMAL_ARRAY_CAPACITY : m_capacity * 2);
+            new (m_items + m_size) T(std::move(item));
+        }
+        else {
+            new (m_items + physicalIndex(m_size)) T(std::forward<Args>(args)...);
+        }
+        m_size++;
+    }
+
+    /**
+     * @brief: iterator over the items of the queue, from the front to the back
+     * @tparam IsConst: whether the items may be changed through the iterator
+     */
+    template<bool IsConst>
+    class BasicIterator {
+    private:
+        typedef typename std::conditional<IsConst, const ArrayQueue, ArrayQueue>::type Container;
+
+        Container* m_queue;
+        std::size_t m_index;
+
+        friend class ArrayQueue;
+        friend class BasicIterator<!IsConst>;
+
+        BasicIterator(Container* queue, std::size_t index) : m_queue(queue), m_index(index) {}
+
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::conditional<IsConst, const T*, T*>::type pointer;
+        typedef typename std::conditional<IsConst, const T&, T&>::type reference;
+
+        /**Exception for invalid operation*/
+        class InvalidOperation {};
+
+        /** Constructor for an iterator that does not point into any queue */
+        BasicIterator() : m_queue(nullptr), m_index(0) {}
+
+        /** A non-const iterator converts to a const one */
+        template<bool OtherIsConst, class = typename std::enable_if<IsConst && !OtherIsConst>::type>
+        BasicIterator(const BasicIterator<OtherIsConst>& other) : m_queue(other.m_queue), m_index(other.m_index) {}
+
+        /**
+         * @brief: dereference operator
+         * @return: reference to the item
+         */
+        reference operator*() const {
+            // An index moved before the front wraps around, so it is past the back as well
+            if (m_queue == nullptr || m_index >= m_queue->m_size) {
+                throw InvalidOperation();
+            }
+            return m_queue->itemAt(m_index);
+        }
+
+        pointer operator->() const {
+            return &**this;
+        }
+
+        reference operator[](difference_type offset) const {
+            return *(*this + offset);
+        }
+
+        /** Operator implementations */
+        BasicIterator& operator++() {
+            if (m_queue == nullptr || m_index >= m_queue->m_size) {
+                throw InvalidOperation();
+            }
+            ++m_index;
+            return *this;
+        }
+
+        BasicIterator operator++(int) {
+            BasicIterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        BasicIterator& operator--() {
+            if (m_queue == nullptr || m_index == 0) {
+                throw InvalidOperation();
+            }
+            --m_index;
+            return *this;
+        }
+
+        BasicIterator operator--(int) {
+            BasicIterator previous = *this;
+            --*this;
+            return previous;
+        }
+
+        BasicIterator& operator+=(difference_type offset) {
+            m_index += static_cast<std::size_t>(offset);
+            return *this;
+        }
+
+        BasicIterator& operator-=(difference_type offset) {
+            m_index -= static_cast<std::size_t>(offset);
+            return *this;
+        }
+
+        BasicIterator operator+(difference_type offset) const {
+            return BasicIterator(m_queue, m_index + static_cast<std::size_t>(offset));
+        }
+
+        friend BasicIterator operator+(difference_type offset, const BasicIterator& iterator) {
+            return iterator + offset;
+        }
+
+        BasicIterator operator-(difference_type offset) const {
+            return BasicIterator(m_queue, m_index - static_cast<std::size_t>(offset));
+        }
+
+        difference_type operator-(const BasicIterator& other) const {
+            return static_cast<difference_type>(m_index - other.m_index);
+        }
+
+        bool operator==(const BasicIterator& other) const {
+            return m_queue == other.m_queue && m_index == other.m_index;
+        }
+
+        bool operator!=(const BasicIterator& other) const {
+            return !(*this == other);
+        }
+
+        bool operator<(const BasicIterator& other) const {
+            return m_index < other.m_index;
+        }
+
+        bool operator>(const BasicIterator& other) const {
+            return other < *this;
+        }
+
+        bool operator<=(const BasicIterator& other) const {
+            return !(other < *this);
+        }
+
+        bool operator>=(const BasicIterator& other) const {
+            return !(*this < other);
+        }
+    };
+
+public:
+    /** Exceptions*/
+    class EmptyQueue {};
+
+    typedef BasicIterator<false> Iterator;
+    typedef BasicIterator<true> ConstIterator;
+
+    /** Constructor for ArrayQueue, no memory is allocated until the first item is pushed */
+    ArrayQueue() : m_items(nullptr), m_capacity(0), m_head(0), m_size(0) {}
+
+    /** Copy constructor for ArrayQueue
+     * @param: other queue to copy
+     *
+     * @return: A new queue with the same items as the "other" queue, with just enough capacity for them
+     */
+    ArrayQueue(const ArrayQueue& other) : ArrayQueue() {
+        reserve(other.m_size);
+        for (std::size_t i = 0; i < other.m_size; ++i) {
+            new (m_items + i) T(other.itemAt(i));
+            m_size++;
+        }
+    }
+
+    /** Move constructor for ArrayQueue
+     * @param: other queue to move from, it is left empty and without a buffer
+     */
+    ArrayQueue(ArrayQueue&& other) noexcept : m_items(other.m_items), m_capacity(other.m_capacity),
+            m_head(other.m_head), m_size(other.m_size) {
+        other.m_items = nullptr;
+        other.m_capacity = 0;
+        other.m_head = 0;
+        other.m_size = 0;
+    }
+
+    /** Assignment operator for ArrayQueue
+     * @param: other queue to copy
+     *
+     * @constraints: In case of alloc fail ,need to throw std::bad_alloc and leave the original queue unchanged
+     *
+     * @return: Reference to the queue, with the same items as the "other" queue
+     */
+    ArrayQueue& operator=(const ArrayQueue& other) {
+        if (this != &other) {
+            ArrayQueue copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    /** Move assignment operator for ArrayQueue
+     * @param: other queue to move from, it is left empty
+     */
+    ArrayQueue& operator=(ArrayQueue&& other) noexcept {
+        if (this != &other) {
+            ArrayQueue temporary(std::move(other));
+            swap(temporary);
+        }
+        return *this;
+    }
+
+    /** swap function
+     * @param: other queue to exchange contents with, in O(1)
+     */
+    void swap(ArrayQueue& other) noexcept {
+        std::swap(m_items, other.m_items);
+        std::swap(m_capacity, other.m_capacity);
+        std::swap(m_head, other.m_head);
+        std::swap(m_size, other.m_size);
+    }
+
+    /** Destructor for ArrayQueue */
+    ~ArrayQueue() {
+        destroyAll();
+        ::operator delete(m_items);
+    }
+
+    Iterator begin() {
+        return Iterator(this, 0);
+    }
+
+    ConstIterator begin() const {
+        return ConstIterator(this, 0);
+    }
+
+    Iterator end() {
+        return Iterator(this, m_size);
+    }
+
+    ConstIterator end() const {
+        return ConstIterator(this, m_size);
+    }
+
+    /** pushBack function
+     * @param: item to insert to the queue, it is copied
+     *
+     * @return reference to the queue, so we can concatenate functions
+     */
+    ArrayQueue& pushBack(const T& toInsert) {
+        emplaceItem(toInsert);
+        return *this;
+    }
+
+    /** pushBack function for temporaries
+     * @param: item to move into the queue
+     *
+     * @return reference to the queue, so we can concatenate functions
+     */
+    ArrayQueue& pushBack(T&& toInsert) {
+        emplaceItem(std::move(toInsert));
+        return *this;
+    }
+
+    /** emplaceBack function
+     * @param: arguments forwarded to the constructor of the new item, which is built inside the buffer
+     *
+     * @return reference to the queue, so we can concatenate functions
+     */
+    template<class... Args>
+    ArrayQueue& emplaceBack(Args&&... args) {
+        emplaceItem(std::forward<Args>(args)...);
+        return *this;
+    }
+
+    /** front function
+     * @return reference to first element of the queue
+     */
+    const T& front() const {
+        if (m_size == 0) {
+            throw EmptyQueue();
+        }
+        return m_items[m_head];
+    }
+
+    T& front() {
+        if (m_size == 0) {
+            throw EmptyQueue();
+        }
+        return m_items[m_head];
+    }
+
+    /**
+     * @description: removes the first element of the queue
+     */
+    void popFront() {
+        if (m_size == 0) {
+            throw EmptyQueue();
+        }
+        m_items[m_head].~T();
+        m_head = physicalIndex(1);
+        m_size--;
+        if (m_size == 0) {
+            m_head = 0;
+        }
+    }
+
+    /**
+     * @param: destination the first element is moved into
+     * @note: if the move throws, the queue is left unchanged
+     */
+    void popFront(T& destination) {
+        if (m_size == 0) {
+            throw EmptyQueue();
+        }
+        destination = std::move(m_items[m_head]);
+        popFront();
+    }
+
+    /**
+     * @description: calls function(first, last) on the items in the order of the queue, once for the items up to the
+     *               end of the buffer and once more for those that wrapped around to its beginning
+     */
+    template<class FUNC>
+    void forEachSpan(FUNC function) {
+        std::size_t firstRun = (m_size < m_capacity - m_head) ? m_size : m_capacity - m_head;
+        if (firstRun != 0) {
+            function(m_items + m_head, m_items + m_head + firstRun);
+        }
+        if (m_size != firstRun) {
+            function(m_items, m_items + (m_size - firstRun));
+        }
+    }
+
+    template<class FUNC>
+    void forEachSpan(FUNC function) const {
+        std::size_t firstRun = (m_size < m_capacity - m_head) ? m_size : m_capacity - m_head;
+        if (firstRun != 0) {
+            function(static_cast<const T*>(m_items + m_head), static_cast<const T*>(m_items + m_head + firstRun));
+        }
+        if (m_size != firstRun) {
+            function(static_cast<const T*>(m_items), static_cast<const T*>(m_items + (m_size - firstRun)));
+        }
+    }
+
+    /**
+     * @return number of elements in the queue
+     */
+    std::size_t size() const {
+        return m_size;
+    }
+
+    /**
+     * @return number of elements the queue can hold before it has to grow
+     */
+    std::size_t capacity() const {
+        return m_capacity;
+    }
+
+    /**
+     * @param: capacity the queue should be able to hold without growing
+     * @note: if an allocation fails, the queue is left unchanged
+     */
+    void reserve(std::size_t newCapacity) {
+        if (newCapacity > m_capacity) {
+            reallocate(newCapacity);
+        }
+    }
+
+    /**
+     * @description: gives back the capacity that is not used by the items of the queue
+     */
+    void shrink_to_fit() {
+        if (m_capacity > m_size) {
+            reallocate(m_size);
+        }
+    }
+};
+
+template<typename T, typename FUNC>
+ArrayQueue<T> filter(const ArrayQueue<T>& queueToFilter, FUNC filterFunction) {
+    ArrayQueue<T> newFilteredQueue;
+    queueToFilter.forEachSpan(FilterKernel<FUNC, ArrayQueue<T>>{filterFunction, &newFilteredQueue});
+    return newFilteredQueue;
+}
+
+template<class T>
+void swap(ArrayQueue<T>& first, ArrayQueue<T>& second) noexcept {
+    first.swap(second);
+}
+
+template<typename T, typename FUNC>
+void transform(ArrayQueue<T>& queueToTransform, FUNC transformFunction) {
+    queueToTransform.forEachSpan(TransformKernel<FUNC>{transformFunction});
+}
+
+#endif // ARRAY_QUEUE_H
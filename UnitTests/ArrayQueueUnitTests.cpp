@@ -0,0 +1,231 @@
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <vector>
+#include "catch.hpp"
+#include "relativeIncludes.h"
+
+TEST_CASE("ArrayQueue int Queue")
+{
+    checkIntQueueScenario<ArrayQueue<int>>();
+}
+
+TEST_CASE("ArrayQueue Basics")
+{
+    SECTION("Wrap around and growth")
+    {
+        ArrayQueue<int> q;
+        q.reserve(8);
+        REQUIRE(q.capacity() == 8);
+        for (int i = 0; i < 8; ++i)
+        {
+            q.pushBack(i);
+        }
+        for (int i = 0; i < 5; ++i)
+        {
+            q.popFront();
+        }
+        for (int i = 8; i < 13; ++i)
+        {
+            q.pushBack(i);
+        }
+        REQUIRE(q.capacity() == 8); // The items wrapped around the end of the buffer
+
+        q.pushBack(13); // Grows while wrapped around
+        REQUIRE(q.capacity() == 16);
+        int expected = 5;
+        for (int item : q)
+        {
+            REQUIRE(item == expected++);
+        }
+        REQUIRE(expected == 14);
+
+        ArrayQueue<int> copyQ = q;
+        REQUIRE(copyQ.capacity() == 9); // Copies are sized to fit
+
+        q.shrink_to_fit();
+        REQUIRE(q.capacity() == 9);
+        REQUIRE(q.front() == 5);
+        REQUIRE(q.begin()[8] == 13);
+    }
+
+    SECTION("Counts are not limited to int")
+    {
+        ArrayQueue<int> q;
+        static_assert(std::is_same<decltype(q.size()), std::size_t>::value, "sizes of an ArrayQueue are size_t");
+        static_assert(std::is_same<decltype(q.capacity()), std::size_t>::value, "capacities are size_t");
+        q.pushBack(1).pushBack(2);
+        // A capacity whose size in bytes does not fit in a size_t is refused before anything is allocated
+        REQUIRE_THROWS_AS(q.reserve(std::numeric_limits<std::size_t>::max()), std::bad_alloc);
+        REQUIRE(q.size() == 2);
+        REQUIRE(q.end() - q.begin() == 2);
+        REQUIRE(*(q.end() + (-1)) == 2);
+        REQUIRE_THROWS_AS(*(q.begin() - 1), ArrayQueue<int>::Iterator::InvalidOperation);
+    }
+
+    SECTION("Random access iterators")
+    {
+        ArrayQueue<int> q;
+        for (int i = 0; i < 6; ++i)
+        {
+            q.pushBack(i);
+        }
+        q.popFront();
+        q.popFront();
+        q.pushBack(9).pushBack(-1).pushBack(7);
+
+        std::sort(q.begin(), q.end());
+        std::vector<int> sorted(q.begin(), q.end());
+        REQUIRE(sorted == std::vector<int>({-1, 2, 3, 4, 5, 7, 9}));
+
+        REQUIRE(q.end() - q.begin() == 7);
+        REQUIRE(*(q.begin() + 3) == 4);
+        REQUIRE(*(q.end() - 1) == 9);
+        REQUIRE(std::lower_bound(q.begin(), q.end(), 5) - q.begin() == 4);
+
+        const ArrayQueue<int>& constQ = q;
+        ArrayQueue<int>::ConstIterator it = q.begin();
+        REQUIRE(it == constQ.begin());
+        REQUIRE(std::count_if(constQ.begin(), constQ.end(), isPrime) == 4);
+
+        std::reverse(q.begin(), q.end());
+        REQUIRE(q.front() == 9);
+    }
+
+    SECTION("Move-only items")
+    {
+        ArrayQueue<std::unique_ptr<int>> q;
+        for (int i = 0; i < 20; ++i)
+        {
+            q.emplaceBack(new int(i));
+        }
+        std::unique_ptr<int> out;
+        q.popFront(out);
+        REQUIRE(*out == 0);
+        ArrayQueue<std::unique_ptr<int>> moved(std::move(q));
+        REQUIRE(q.size() == 0);
+        REQUIRE(moved.size() == 19);
+        REQUIRE(*moved.front() == 1);
+    }
+
+    SECTION("Bad Allocs")
+    {
+        ControlledAllocer::allowedAllocs = 1000;
+        ArrayQueue<ControlledAllocer> q1, q2;
+        ControlledAllocer c;
+        for (int i = 0; i < 8; i++)
+        {
+            q1.pushBack(c);
+        }
+        q1.front().someInteger = 666;
+
+        // Growing copies the items, since ControlledAllocer has no noexcept move
+        ControlledAllocer::allowedAllocs = 3;
+        REQUIRE_THROWS_AS(q1.pushBack(c), std::bad_alloc);
+        REQUIRE(q1.size() == 8);
+        REQUIRE(q1.capacity() == 8);
+        REQUIRE(q1.front().someInteger == 666);
+
+        ControlledAllocer::allowedAllocs = 5;
+        REQUIRE_THROWS_AS(q2 = q1, std::bad_alloc);
+        REQUIRE(q2.size() == 0);
+        REQUIRE_THROWS_AS(ArrayQueue<ControlledAllocer>(q1), std::bad_alloc);
+    }
+
+    SECTION("filter and transform over a wrapped buffer")
+    {
+        ArrayQueue<int> q;
+        for (int i = 0; i < 1000; i++){
+            q.pushBack(i);
+        }
+        for (int i = 0; i < 600; i++){
+            q.popFront();
+        }
+        for (int i = 1000; i < 1500; i++){
+            q.pushBack(i);
+        }
+        REQUIRE(q.capacity() == 1024);
+
+        std::vector<int> expected;
+        std::copy_if(q.begin(), q.end(), std::back_inserter(expected), isPrime);
+        ArrayQueue<int> primesQ = filter(q, isPrime);
+        REQUIRE(std::vector<int>(primesQ.begin(), primesQ.end()) == expected);
+
+        // The function is not copied between the two runs, so its state carries over
+        int counter = 0;
+        transform(q, [counter](int& n) mutable { n = counter++; });
+        for (int i = 0; i < 900; i++){
+            REQUIRE(q.front() == i);
+            q.popFront();
+        }
+    }
+
+    SECTION("filter of floats")
+    {
+        ArrayQueue<float> q;
+        for (int i = 0; i < 1000; i++){
+            q.pushBack(i * 0.5f);
+        }
+        ArrayQueue<float> smallQ = filter(q, [](float f) { return f < 100.0f; });
+        REQUIRE(smallQ.size() == 200);
+        REQUIRE(*(smallQ.begin() + 199) == 99.5f);
+
+        ArrayQueue<float> comparedQ = filter(q, lessThan(100.0f));
+        REQUIRE(comparedQ.size() == 200);
+        REQUIRE(*(comparedQ.begin() + 199) == 99.5f);
+        REQUIRE(filter(q, equalTo(0.5f)).size() == 1);
+    }
+
+    SECTION("Comparison filters give the items of the scalar kernel")
+    {
+        std::vector<int> ints;
+        std::vector<float> floats;
+        unsigned int seed = 1984;
+        for (int i = 0; i < 1000; i++){
+            seed = seed * 1103515245 + 12345;
+            ints.push_back(static_cast<int>((seed >> 8) % 200) - 100);
+            floats.push_back(static_cast<float>(ints.back()) * 0.25f);
+        }
+        ArrayQueue<int> q;
+        for (int i = 0; i < 300; i++){
+            q.pushBack(0);
+        }
+        for (int i = 0; i < 300; i++){
+            q.popFront();
+        }
+        for (int n : ints){
+            q.pushBack(n);
+        }
+        std::vector<int> expected;
+        std::copy_if(ints.begin(), ints.end(), std::back_inserter(expected), [](int n) { return n < 7; });
+        ArrayQueue<int> lessQ = filter(q, lessThan(7));
+        REQUIRE(std::vector<int>(lessQ.begin(), lessQ.end()) == expected);
+        REQUIRE(filter(q, greaterThan(-100)).size() + filter(q, equalTo(-100)).size() == 1000);
+
+        // Every kernel the CPU supports, on runs that do not end on a whole vector
+        std::vector<int> intsOut(ints.size());
+        std::vector<float> floatsOut(floats.size());
+        CompareTo<int, COMPARE_GREATER> greater = greaterThan(13);
+        CompareTo<float, COMPARE_EQUAL> equal = equalTo(2.5f);
+        std::size_t intsPassed = compactSpanScalar(ints.data(), ints.data() + 997, greater, intsOut.data());
+        std::size_t floatsPassed = compactSpanScalar(floats.data(), floats.data() + 997, equal, floatsOut.data());
+        std::vector<int> expectedInts(intsOut.begin(), intsOut.begin() + intsPassed);
+        std::vector<float> expectedFloats(floatsOut.begin(), floatsOut.begin() + floatsPassed);
+        REQUIRE(expectedFloats.size() != 0);
+#ifdef SPAN_KERNELS_X86
+        if (cpuFeatures().m_avx2){
+            REQUIRE(compactSpanAvx2(ints.data(), ints.data() + 997, greater, intsOut.data()) == intsPassed);
+            REQUIRE(std::vector<int>(intsOut.begin(), intsOut.begin() + intsPassed) == expectedInts);
+            REQUIRE(compactSpanAvx2(floats.data(), floats.data() + 997, equal, floatsOut.data()) == floatsPassed);
+            REQUIRE(std::vector<float>(floatsOut.begin(), floatsOut.begin() + floatsPassed) == expectedFloats);
+        }
+        if (cpuFeatures().m_avx512){
+            REQUIRE(compactSpanAvx512(ints.data(), ints.data() + 997, greater, intsOut.data()) == intsPassed);
+            REQUIRE(std::vector<int>(intsOut.begin(), intsOut.begin() + intsPassed) == expectedInts);
+            REQUIRE(compactSpanAvx512(floats.data(), floats.data() + 997, equal, floatsOut.data()) == floatsPassed);
+            REQUIRE(std::vector<float>(floatsOut.begin(), floatsOut.begin() + floatsPassed) == expectedFloats);
+        }
+#endif
+    }
+}
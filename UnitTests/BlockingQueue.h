@@ -0,0 +1,222 @@
+#ifndef BLOCKING_QUEUE_H
+#define BLOCKING_QUEUE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include "Queue.h"
+
+/**
+ * @brief: BlockingQueue class, a bounded queue shared by threads, which applies backpressure to its producers
+ * @tparam T: type of the items in the queue
+ *
+ * @note: the items are kept in a Queue behind a mutex. A producer that finds the queue full waits for room, or
+ *        fails at once under the FAIL_FAST policy, and a consumer that finds it empty waits for an item.
+ */
+template<class T>
+class BlockingQueue {
+public:
+    /** What pushBack does when the queue is full */
+    enum class FullPolicy { BLOCK, FAIL_FAST };
+
+    /** Exceptions*/
+    class FullQueue {};
+    class InvalidCapacity {};
+
+private:
+    Queue<T> m_queue;
+    std::size_t m_capacity;
+    FullPolicy m_policy;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_notFull;
+    std::condition_variable m_notEmpty;
+
+    bool isFull() const {
+        return m_queue.size() >= m_capacity;
+    }
+
+    bool isEmpty() const {
+        return m_queue.size() == EMPTY;
+    }
+
+    /**
+     * @description: inserts the item and wakes a waiting consumer
+     * @note: the lock must be held and the queue must not be full
+     */
+    template<class U>
+    void insert(std::unique_lock<std::mutex>& lock, U&& item) {
+        m_queue.pushBack(std::forward<U>(item));
+        lock.unlock();
+        m_notEmpty.notify_one();
+    }
+
+    /**
+     * @description: moves the first item out and wakes a waiting producer
+     * @note: the lock must be held and the queue must not be empty
+     */
+    void extract(std::unique_lock<std::mutex>& lock, T& destination) {
+        m_queue.popFront(destination);
+        lock.unlock();
+        m_notFull.notify_one();
+    }
+
+    template<class U>
+    void push(U&& item) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_policy == FullPolicy::FAIL_FAST) {
+            if (isFull()) {
+                throw FullQueue();
+            }
+        }
+        else {
+            m_notFull.wait(lock, [this]() { return !isFull(); });
+        }
+        insert(lock, std::forward<U>(item));
+    }
+
+    template<class U, class Clock, class Duration>
+    bool pushUntil(U&& item, const std::chrono::time_point<Clock, Duration>& deadline) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!m_notFull.wait_until(lock, deadline, [this]() { return !isFull(); })) {
+            return false;
+        }
+        insert(lock, std::forward<U>(item));
+        return true;
+    }
+
+public:
+    /** Constructor for BlockingQueue
+     * @param: capacity - the most items the queue holds at once, must be positive
+     * @param: policy - whether pushBack waits for room or throws FullQueue when the queue is full
+     */
+    explicit BlockingQueue(std::size_t capacity, FullPolicy policy = FullPolicy::BLOCK) :
+            m_queue(), m_capacity(capacity), m_policy(policy) {
+        if (capacity == 0) {
+            throw InvalidCapacity();
+        }
+    }
+
+    /** The queue is shared by threads through its address, so it is never copied or moved */
+    BlockingQueue(const BlockingQueue& other) = delete;
+    BlockingQueue& operator=(const BlockingQueue& other) = delete;
+
+    /** pushBack function
+     * @param: item to insert to the queue, it is copied
+     * @throw: FullQueue if the queue is full under the FAIL_FAST policy, otherwise waits for room
+     */
+    void pushBack(const T& toInsert) {
+        push(toInsert);
+    }
+
+    /** pushBack function for temporaries
+     * @param: item to move into the queue
+     * @throw: FullQueue if the queue is full under the FAIL_FAST policy, otherwise waits for room
+     */
+    void pushBack(T&& toInsert) {
+        push(std::move(toInsert));
+    }
+
+    /** tryPushUntil function
+     * @param: item to insert to the queue, it is copied
+     * @param: deadline - the time to stop waiting for room at, regardless of the policy. A caller that retries
+     *         passes the same deadline again, without recomputing what is left of its timeout.
+     *
+     * @return true if the item was inserted, false if the queue stayed full until the deadline
+     * @note: the item is inserted even past the deadline if there is room at once
+     */
+    template<class Clock, class Duration>
+    bool tryPushUntil(const T& toInsert, const std::chrono::time_point<Clock, Duration>& deadline) {
+        return pushUntil(toInsert, deadline);
+    }
+
+    template<class Clock, class Duration>
+    bool tryPushUntil(T&& toInsert, const std::chrono::time_point<Clock, Duration>& deadline) {
+        return pushUntil(std::move(toInsert), deadline);
+    }
+
+    /** tryPushFor function
+     * @param: item to insert to the queue, it is copied
+     * @param: timeout - the longest time to wait for room, regardless of the policy
+     *
+     * @return true if the item was inserted, false if the queue stayed full until the deadline
+     */
+    template<class Rep, class Period>
+    bool tryPushFor(const T& toInsert, const std::chrono::duration<Rep, Period>& timeout) {
+        return tryPushUntil(toInsert, std::chrono::steady_clock::now() + timeout);
+    }
+
+    template<class Rep, class Period>
+    bool tryPushFor(T&& toInsert, const std::chrono::duration<Rep, Period>& timeout) {
+        return tryPushUntil(std::move(toInsert), std::chrono::steady_clock::now() + timeout);
+    }
+
+    /**
+     * @param: destination the first item is moved into, waits for an item if the queue is empty
+     */
+    void popFront(T& destination) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notEmpty.wait(lock, [this]() { return !isEmpty(); });
+        extract(lock, destination);
+    }
+
+    /**
+     * @description: waits for an item if the queue is empty
+     * @return the first item, moved out of the queue
+     */
+    T popFront() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notEmpty.wait(lock, [this]() { return !isEmpty(); });
+        T item(std::move(m_queue.front()));
+        m_queue.popFront();
+        lock.unlock();
+        m_notFull.notify_one();
+        return item;
+    }
+
+    /** tryPopUntil function
+     * @param: destination the first item is moved into
+     * @param: deadline - the time to stop waiting for an item at
+     *
+     * @return true if an item was moved out, false if the queue stayed empty until the deadline
+     * @note: an item is moved out even past the deadline if there is one at once
+     */
+    template<class Clock, class Duration>
+    bool tryPopUntil(T& destination, const std::chrono::time_point<Clock, Duration>& deadline) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!m_notEmpty.wait_until(lock, deadline, [this]() { return !isEmpty(); })) {
+            return false;
+        }
+        extract(lock, destination);
+        return true;
+    }
+
+    /** tryPopFor function
+     * @param: destination the first item is moved into
+     * @param: timeout - the longest time to wait for an item
+     *
+     * @return true if an item was moved out, false if the queue stayed empty until the deadline
+     */
+    template<class Rep, class Period>
+    bool tryPopFor(T& destination, const std::chrono::duration<Rep, Period>& timeout) {
+        return tryPopUntil(destination, std::chrono::steady_clock::now() + timeout);
+    }
+
+    /**
+     * @return number of items in the queue, only a snapshot while other threads use it
+     */
+    std::size_t size() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_queue.size();
+    }
+
+    /**
+     * @return the most items the queue holds at once
+     */
+    std::size_t capacity() const {
+        return m_capacity;
+    }
+};
+
+#endif // BLOCKING_QUEUE_H
@@ -0,0 +1,116 @@
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "catch.hpp"
+#include "relativeIncludes.h"
+
+TEST_CASE("BlockingQueue Basics")
+{
+    SECTION("Capacity and policies")
+    {
+        REQUIRE_THROWS_AS(BlockingQueue<int>(0), BlockingQueue<int>::InvalidCapacity);
+
+        BlockingQueue<int> q(2, BlockingQueue<int>::FullPolicy::FAIL_FAST);
+        REQUIRE(q.capacity() == 2);
+        static_assert(std::is_same<decltype(q.capacity()), std::size_t>::value, "capacities are size_t");
+        q.pushBack(1);
+        q.pushBack(2);
+        REQUIRE_THROWS_AS(q.pushBack(3), BlockingQueue<int>::FullQueue);
+        REQUIRE(q.size() == 2);
+        REQUIRE_FALSE(q.tryPushFor(3, std::chrono::milliseconds(1)));
+
+        REQUIRE(q.popFront() == 1);
+        REQUIRE(q.tryPushFor(3, std::chrono::milliseconds(1)));
+        int out = 0;
+        q.popFront(out);
+        REQUIRE(out == 2);
+        REQUIRE(q.tryPopFor(out, std::chrono::milliseconds(1)));
+        REQUIRE(out == 3);
+        REQUIRE_FALSE(q.tryPopFor(out, std::chrono::milliseconds(1)));
+        REQUIRE(out == 3);
+        REQUIRE(q.size() == 0);
+    }
+
+    SECTION("Deadlines")
+    {
+        BlockingQueue<int> q(1);
+        std::chrono::steady_clock::time_point expired = std::chrono::steady_clock::now() - std::chrono::seconds(1);
+        int out = 0;
+        REQUIRE_FALSE(q.tryPopUntil(out, expired));
+        REQUIRE(q.tryPushUntil(1, expired)); // There is room at once, so the deadline does not matter
+        REQUIRE_FALSE(q.tryPushUntil(2, expired));
+        REQUIRE(q.size() == 1);
+        REQUIRE(q.tryPopUntil(out, expired));
+        REQUIRE(out == 1);
+
+        // A consumer waits for an item up to its deadline
+        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        std::thread producer([&q]()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            q.pushBack(3);
+        });
+        REQUIRE(q.tryPopUntil(out, deadline));
+        producer.join();
+        REQUIRE(out == 3);
+        REQUIRE(std::chrono::steady_clock::now() < deadline);
+    }
+
+    SECTION("Move-only items")
+    {
+        BlockingQueue<std::unique_ptr<int>> q(4);
+        q.pushBack(std::unique_ptr<int>(new int(7)));
+        REQUIRE(q.tryPushFor(std::unique_ptr<int>(new int(8)), std::chrono::milliseconds(1)));
+        std::unique_ptr<int> out = q.popFront();
+        REQUIRE(*out == 7);
+        REQUIRE(q.tryPopFor(out, std::chrono::milliseconds(1)));
+        REQUIRE(*out == 8);
+    }
+
+    SECTION("Producers wait for room")
+    {
+        const int itemsCount = 10000;
+        BlockingQueue<int> q(8);
+        std::atomic<int> largestSize(0);
+        std::thread producer([&q, itemsCount]()
+        {
+            for (int i = 0; i < itemsCount; ++i)
+            {
+                q.pushBack(i);
+            }
+        });
+
+        bool inOrder = true;
+        for (int i = 0; i < itemsCount; ++i)
+        {
+            int size = q.size();
+            if (size > largestSize.load())
+            {
+                largestSize.store(size);
+            }
+            inOrder = inOrder && (q.popFront() == i);
+        }
+        producer.join();
+        REQUIRE(inOrder);
+        REQUIRE(largestSize.load() <= 8);
+        REQUIRE(q.size() == 0);
+    }
+
+    SECTION("Consumers wait for items")
+    {
+        BlockingQueue<int> q(1);
+        int received = 0;
+        std::thread consumer([&q, &received]()
+        {
+            received = q.popFront();
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        q.pushBack(42);
+        consumer.join();
+        REQUIRE(received == 42);
+    }
+}
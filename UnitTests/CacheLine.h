@@ -0,0 +1,36 @@
+#ifndef CACHE_LINE_H
+#define CACHE_LINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+/** Fields written by different threads are aligned this far apart, so they never share a cache line */
+static const std::size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * @brief: CacheLineAligned class, a base for the objects holding cache line aligned fields that live on the heap
+ *
+ * @note: before C++17 a new-expression does not honor an alignment bigger than the one of std::max_align_t, so the
+ *        objects are allocated a cache line larger, and the address of the block is kept right before the object
+ */
+struct CacheLineAligned {
+    static void* operator new(std::size_t size) {
+        void* block = std::malloc(size + CACHE_LINE_SIZE);
+        if (block == nullptr) {
+            throw std::bad_alloc();
+        }
+        std::uintptr_t aligned = (reinterpret_cast<std::uintptr_t>(block) + CACHE_LINE_SIZE) & ~(CACHE_LINE_SIZE - 1);
+        reinterpret_cast<void**>(aligned)[-1] = block;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    static void operator delete(void* object) noexcept {
+        if (object != nullptr) {
+            std::free(reinterpret_cast<void**>(object)[-1]);
+        }
+    }
+};
+
+#endif // CACHE_LINE_H
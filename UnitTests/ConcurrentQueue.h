@@ -0,0 +1,184 @@
+#ifndef CONCURRENT_QUEUE_H
+#define CONCURRENT_QUEUE_H
+
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "CacheLine.h"
+#include "HazardPointers.h"
+
+/**
+ * @brief: ConcurrentQueue class, an unbounded lock-free queue for any number of producers and consumers
+ * @tparam T: type of the items in the queue
+ *
+ * @note: the Michael-Scott queue. The head always points to a dummy node, whose successor holds the first item.
+ *        Head and tail move forward with compare-and-swap, and a thread that finds the tail lagging helps it on.
+ * @note: popped nodes are retired through HazardPointers, so a node is never freed while another thread reads it
+ * @note: the move assignment of T must be noexcept, since an item is moved out only after its node was unlinked
+ * @note: there is no size(), keeping a shared count would add two contended atomic operations to every item
+ */
+template<class T>
+class ConcurrentQueue {
+    static_assert(std::is_nothrow_move_assignable<T>::value,
+                  "ConcurrentQueue moves items out of unlinked nodes, so T needs a noexcept move assignment");
+
+private:
+    /** Tag for the constructor of the nodes that hold an item */
+    struct WithItem {};
+
+    class Node {
+    private:
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type m_item;
+
+    public:
+        std::atomic<Node*> m_next;
+
+        /** Constructor for the dummy node, which holds no item */
+        Node() : m_next(nullptr) {}
+
+        /**
+         * @description: Constructor for Node that builds the item in place
+         * @param: arguments forwarded to the constructor of the item
+         * @note: the item is destroyed by the thread that pops it, never by the node
+         */
+        template<class... Args>
+        explicit Node(WithItem, Args&&... args) : m_next(nullptr) {
+            new (&m_item) T(std::forward<Args>(args)...);
+        }
+
+        T& getReferenceToItem() {
+            return *reinterpret_cast<T*>(&m_item);
+        }
+    };
+
+    static const int HEAD_SLOT = 0;
+    static const int NEXT_SLOT = 1;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<Node*> m_head;
+    alignas(CACHE_LINE_SIZE) std::atomic<Node*> m_tail;
+
+    /**
+     * @description: links the node after the last node and moves the tail to it
+     */
+    void linkBack(Node* node) {
+        while (true) {
+            Node* tail = HazardPointers::protect(HEAD_SLOT, m_tail);
+            Node* next = tail->m_next.load();
+            if (tail != m_tail.load()) {
+                continue;
+            }
+            if (next != nullptr) {
+                // The tail is lagging behind, help it forward
+                m_tail.compare_exchange_weak(tail, next);
+                continue;
+            }
+            if (tail->m_next.compare_exchange_weak(next, node)) {
+                m_tail.compare_exchange_strong(tail, node);
+                break;
+            }
+        }
+        HazardPointers::clear(HEAD_SLOT);
+    }
+
+public:
+    /** Exceptions*/
+    class EmptyQueue {};
+
+    /** Constructor for ConcurrentQueue */
+    ConcurrentQueue() : m_head(new Node()), m_tail(m_head.load()) {}
+
+    /** The queue is shared by threads through its address, so it is never copied or moved */
+    ConcurrentQueue(const ConcurrentQueue& other) = delete;
+    ConcurrentQueue& operator=(const ConcurrentQueue& other) = delete;
+
+    /** Destructor for ConcurrentQueue, must not run while another thread still uses the queue */
+    ~ConcurrentQueue() {
+        Node* dummy = m_head.load();
+        Node* node = dummy->m_next.load();
+        delete dummy;
+        while (node != nullptr) {
+            Node* next = node->m_next.load();
+            node->getReferenceToItem().~T();
+            delete node;
+            node = next;
+        }
+    }
+
+    /** pushBack function
+     * @param: arguments forwarded to the constructor of the new item
+     * @throw: std::bad_alloc if the node could not be allocated, the queue is unchanged then
+     */
+    template<class... Args>
+    void pushBack(Args&&... args) {
+        linkBack(new Node(WithItem(), std::forward<Args>(args)...));
+    }
+
+    /** tryPush function
+     * @param: arguments forwarded to the constructor of the new item
+     *
+     * @return true if the item was inserted, false if the node could not be allocated
+     */
+    template<class... Args>
+    bool tryPush(Args&&... args) {
+        Node* node;
+        try {
+            node = new Node(WithItem(), std::forward<Args>(args)...);
+        }
+        catch (const std::bad_alloc& e) {
+            return false;
+        }
+        linkBack(node);
+        return true;
+    }
+
+    /** tryPop function
+     * @param: destination the first item is moved into
+     *
+     * @return true if an item was moved out, false if the queue was empty
+     */
+    bool tryPop(T& destination) {
+        while (true) {
+            Node* head = HazardPointers::protect(HEAD_SLOT, m_head);
+            Node* tail = m_tail.load();
+            Node* next = HazardPointers::protect(NEXT_SLOT, head->m_next);
+            if (head != m_head.load()) {
+                continue;
+            }
+            if (next == nullptr) {
+                HazardPointers::clear(HEAD_SLOT);
+                HazardPointers::clear(NEXT_SLOT);
+                return false;
+            }
+            if (head == tail) {
+                // The tail is lagging behind, help it forward
+                m_tail.compare_exchange_weak(tail, next);
+                continue;
+            }
+            if (m_head.compare_exchange_weak(head, next)) {
+                // Only this thread won "next", and its hazard slot keeps it alive, so the item is read after the swap.
+                // Neither the move nor retire can throw, so the hazard slots are always cleared and the old dummy
+                // always retired, once the pop took effect.
+                T& item = next->getReferenceToItem();
+                destination = std::move(item);
+                item.~T();
+                HazardPointers::clear(HEAD_SLOT);
+                HazardPointers::clear(NEXT_SLOT);
+                HazardPointers::retire(head);
+                return true;
+            }
+        }
+    }
+
+    /**
+     * @param: destination the first item is moved into
+     * @throw: EmptyQueue if the queue was empty
+     */
+    void popFront(T& destination) {
+        if (!tryPop(destination)) {
+            throw EmptyQueue();
+        }
+    }
+};
+
+#endif // CONCURRENT_QUEUE_H
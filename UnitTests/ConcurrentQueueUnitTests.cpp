@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "catch.hpp"
+#include "relativeIncludes.h"
+
+TEST_CASE("ConcurrentQueue Basics")
+{
+    SECTION("Single thread")
+    {
+        ConcurrentQueue<int> q;
+        int out = -1;
+        REQUIRE_FALSE(q.tryPop(out));
+        REQUIRE_THROWS_AS(q.popFront(out), ConcurrentQueue<int>::EmptyQueue);
+        REQUIRE(out == -1);
+        // A pop that took effect is never turned into an exception by the reclamation
+        REQUIRE(noexcept(HazardPointers::retire(static_cast<int*>(nullptr))));
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            REQUIRE(q.tryPush(i));
+        }
+        q.pushBack(1000);
+        for (int i = 0; i <= 1000; ++i)
+        {
+            REQUIRE(q.tryPop(out));
+            REQUIRE(out == i);
+        }
+        REQUIRE_FALSE(q.tryPop(out));
+    }
+
+    SECTION("Items are destroyed exactly once")
+    {
+        std::shared_ptr<int> item(new int(1));
+        {
+            ConcurrentQueue<std::shared_ptr<int>> q;
+            for (int i = 0; i < 200; ++i)
+            {
+                q.pushBack(item);
+            }
+            std::shared_ptr<int> out;
+            for (int i = 0; i < 150; ++i)
+            {
+                q.popFront(out);
+            }
+            out.reset();
+            REQUIRE(item.use_count() == 51);
+        }
+        REQUIRE(item.use_count() == 1);
+    }
+
+    SECTION("Many producers and many consumers")
+    {
+        const int threadsCount = 4;
+        const int itemsPerProducer = 20000;
+        ConcurrentQueue<int> q;
+        std::atomic<int> popped(0);
+        std::vector<std::vector<int>> received(threadsCount);
+        std::vector<std::thread> threads;
+
+        for (int producer = 0; producer < threadsCount; ++producer)
+        {
+            threads.emplace_back([&q, producer, itemsPerProducer]()
+            {
+                for (int i = 0; i < itemsPerProducer; ++i)
+                {
+                    q.pushBack(producer * itemsPerProducer + i);
+                }
+            });
+        }
+        for (int consumer = 0; consumer < threadsCount; ++consumer)
+        {
+            threads.emplace_back([&q, &popped, &received, consumer, threadsCount, itemsPerProducer]()
+            {
+                int out = 0;
+                while (popped.load() < threadsCount * itemsPerProducer)
+                {
+                    if (q.tryPop(out))
+                    {
+                        received[consumer].push_back(out);
+                        popped.fetch_add(1);
+                    }
+                    else
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        // Every item arrived once, and the items of each producer arrived to each consumer in order
+        std::vector<int> all;
+        bool inOrder = true;
+        for (const std::vector<int>& items : received)
+        {
+            std::vector<int> lastOfProducer(threadsCount, -1);
+            for (int item : items)
+            {
+                int producer = item / itemsPerProducer;
+                inOrder = inOrder && (item > lastOfProducer[producer]);
+                lastOfProducer[producer] = item;
+            }
+            all.insert(all.end(), items.begin(), items.end());
+        }
+        std::sort(all.begin(), all.end());
+        REQUIRE(inOrder);
+        REQUIRE(all.size() == threadsCount * itemsPerProducer);
+        bool complete = true;
+        for (int i = 0; i < static_cast<int>(all.size()); ++i)
+        {
+            complete = complete && (all[i] == i);
+        }
+        REQUIRE(complete);
+        int out = 0;
+        REQUIRE_FALSE(q.tryPop(out));
+    }
+}
@@ -0,0 +1,281 @@
+#ifndef COW_QUEUE_H
+#define COW_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include "Queue.h"
+
+/**
+ * @brief: CowQueue class, a Queue whose copies share their nodes until one of them is changed
+ * @tparam T: type of the items in the queue
+ * @tparam Alloc: allocator of the underlying Queue
+ *
+ * @note: a copy only takes a reference to the Queue of the original, in O(1). The first call that may change the
+ *        items (pushBack, popFront, the non-const front and begin) detaches the copy by deep copying the Queue, if
+ *        it is still shared, so every handle behaves like a Queue of its own.
+ * @note: once the non-const front or begin has handed out a reference, the handle is unshareable: copies of it
+ *        are deep copies, since the reference could still change the items. It becomes shareable again when every
+ *        reference is known to be gone, that is when the queue is popped empty or assigned to.
+ * @note: iterate a shared queue through a const reference, the non-const begin() detaches
+ * @note: a moved handle hands its Queue over in O(1), even an unshareable one, and is left empty. Empty handles
+ *        share one empty Queue, so they are made without allocating.
+ * @note: handles that share a Queue may be used and destroyed by different threads, a single handle may not. A
+ *        stateful allocator must give the copies of a Queue their own state, like PoolAllocator does, since the
+ *        handles detach on their own threads.
+ */
+template<class T, class Alloc = std::allocator<T>>
+class CowQueue {
+public:
+    typedef Queue<T, Alloc> SharedQueue;
+    typedef typename SharedQueue::Iterator Iterator;
+    typedef typename SharedQueue::ConstIterator ConstIterator;
+    typedef typename SharedQueue::EmptyQueue EmptyQueue;
+
+private:
+    std::shared_ptr<SharedQueue> m_queue;
+    bool m_unshareable;
+
+    /**
+     * @return the empty Queue every empty handle starts with, it is never changed since it is always shared
+     */
+    static const std::shared_ptr<SharedQueue>& emptyQueue() {
+        static const std::shared_ptr<SharedQueue> empty = std::make_shared<SharedQueue>();
+        return empty;
+    }
+
+    /**
+     * @description: gives this handle a Queue of its own before it is changed
+     * @note: if the deep copy throws, the handle still shares the original Queue
+     */
+    SharedQueue& detach() {
+        if (m_queue.use_count() != 1) {
+            m_queue = std::make_shared<SharedQueue>(*m_queue);
+        }
+        else {
+            // The other handles may have just been released on other threads, their reads come before our writes
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        return *m_queue;
+    }
+
+    /**
+     * @return the Queue a copy of "other" starts with, its own if "other" handed out references to its items
+     */
+    static std::shared_ptr<SharedQueue> shareOrCopy(const CowQueue& other) {
+        if (other.m_unshareable) {
+            return std::make_shared<SharedQueue>(*other.m_queue);
+        }
+        return other.m_queue;
+    }
+
+    /**
+     * @description: gives this handle a Queue of its own that no other handle will share, so references to its
+     *               items may be handed out
+     */
+    SharedQueue& detachUnshareable() {
+        SharedQueue& queue = detach();
+        m_unshareable = true;
+        return queue;
+    }
+
+    /**
+     * @description: the items are all gone, and the references to them with the items
+     */
+    void releaseIfEmpty() {
+        if (m_queue->size() == EMPTY) {
+            m_unshareable = false;
+        }
+    }
+
+public:
+    /** Constructor for CowQueue */
+    CowQueue() : m_queue(emptyQueue()), m_unshareable(false) {}
+
+    /** Constructor for CowQueue from a Queue
+     * @param: queue whose nodes are taken over
+     * @note: the shared empty Queue is made here at the latest, so that moving a handle never allocates
+     */
+    explicit CowQueue(SharedQueue queue) :
+            m_queue(std::make_shared<SharedQueue>(std::move(queue))), m_unshareable(false) {
+        emptyQueue();
+    }
+
+    /** Copy constructor for CowQueue, shares the Queue of "other" in O(1), or deep copies it if it is unshareable */
+    CowQueue(const CowQueue& other) : m_queue(shareOrCopy(other)), m_unshareable(false) {}
+
+    /** Assignment operator for CowQueue, shares the Queue of "other" like the copy constructor and releases the
+     *  original
+     * @note: if the deep copy throws, the handle is unchanged
+     */
+    CowQueue& operator=(const CowQueue& other) {
+        m_queue = shareOrCopy(other);
+        m_unshareable = false;
+        return *this;
+    }
+
+    /** Move constructor for CowQueue
+     * @param: other handle, its Queue is taken over in O(1) along with the references it handed out, and it is
+     *         left empty
+     */
+    CowQueue(CowQueue&& other) noexcept : m_queue(std::move(other.m_queue)), m_unshareable(other.m_unshareable) {
+        other.m_queue = emptyQueue();
+        other.m_unshareable = false;
+    }
+
+    /** Move assignment operator for CowQueue
+     * @param: other handle, its Queue is taken over in O(1) and it is left empty
+     */
+    CowQueue& operator=(CowQueue&& other) noexcept {
+        if (this != &other) {
+            m_queue = std::move(other.m_queue);
+            m_unshareable = other.m_unshareable;
+            other.m_queue = emptyQueue();
+            other.m_unshareable = false;
+        }
+        return *this;
+    }
+
+    /** swap function
+     * @param: other handle to exchange queues with, in O(1)
+     */
+    void swap(CowQueue& other) noexcept {
+        m_queue.swap(other.m_queue);
+        std::swap(m_unshareable, other.m_unshareable);
+    }
+
+    /**
+     * @return true if other handles share the Queue of this one
+     */
+    bool isShared() const {
+        return m_queue.use_count() != 1;
+    }
+
+    /**
+     * @return the Queue of the handle, for reading
+     */
+    const SharedQueue& queue() const {
+        return *m_queue;
+    }
+
+    /** pushBack function
+     * @param: item to insert to the queue, it is copied
+     * @return reference to the queue, so we can concatenate functions
+     */
+    CowQueue& pushBack(const T& toInsert) {
+        detach().pushBack(toInsert);
+        return *this;
+    }
+
+    /** pushBack function for temporaries
+     * @param: item to move into the queue
+     * @return reference to the queue, so we can concatenate functions
+     */
+    CowQueue& pushBack(T&& toInsert) {
+        detach().pushBack(std::move(toInsert));
+        return *this;
+    }
+
+    /** emplaceBack function
+     * @param: arguments forwarded to the constructor of the new item
+     * @return reference to the queue, so we can concatenate functions
+     */
+    template<class... Args>
+    CowQueue& emplaceBack(Args&&... args) {
+        detach().emplaceBack(std::forward<Args>(args)...);
+        return *this;
+    }
+
+    /**
+     * @return reference to first element of the queue, the queue stays shared
+     */
+    const T& front() const {
+        return m_queue->front();
+    }
+
+    /**
+     * @return reference to first element of the queue, detached so it may be changed
+     * @note: the handle is unshareable from here on
+     */
+    T& front() {
+        if (m_queue->size() == EMPTY) {
+            throw EmptyQueue();
+        }
+        return detachUnshareable().front();
+    }
+
+    /**
+     * @description: removes the first element of the queue
+     */
+    void popFront() {
+        if (m_queue->size() == EMPTY) {
+            throw EmptyQueue();
+        }
+        detach().popFront();
+        releaseIfEmpty();
+    }
+
+    /**
+     * @param: destination the first element is moved into, before it is removed
+     */
+    void popFront(T& destination) {
+        if (m_queue->size() == EMPTY) {
+            throw EmptyQueue();
+        }
+        detach().popFront(destination);
+        releaseIfEmpty();
+    }
+
+    /** begin() function for iterators that may change the items, detaches and makes the handle unshareable */
+    Iterator begin() {
+        return detachUnshareable().begin();
+    }
+
+    Iterator end() {
+        return m_queue->end();
+    }
+
+    /** begin() function for const iterators, the queue stays shared */
+    ConstIterator begin() const {
+        return static_cast<const SharedQueue&>(*m_queue).begin();
+    }
+
+    ConstIterator end() const {
+        return static_cast<const SharedQueue&>(*m_queue).end();
+    }
+
+    /**
+     * @return copy of the allocator of the queue
+     */
+    Alloc get_allocator() const {
+        return m_queue->get_allocator();
+    }
+
+    /**
+     * @return number of elements in the queue
+     */
+    std::size_t size() const {
+        return m_queue->size();
+    }
+};
+
+template<typename T, class Alloc, typename FUNC>
+CowQueue<T, Alloc> filter(const CowQueue<T, Alloc>& queueToFilter, FUNC filterFunction) {
+    return CowQueue<T, Alloc>(filter(queueToFilter.queue(), filterFunction));
+}
+
+template<class T, class Alloc>
+void swap(CowQueue<T, Alloc>& first, CowQueue<T, Alloc>& second) noexcept {
+    first.swap(second);
+}
+
+template<typename T, class Alloc, typename FUNC>
+void transform(CowQueue<T, Alloc>& queueToTransform, FUNC transformFunction) {
+    for (typename CowQueue<T, Alloc>::Iterator i = queueToTransform.begin(); i != queueToTransform.end(); ++i) {
+        T& itemReference = *i;
+        transformFunction(itemReference);
+    }
+}
+
+#endif // COW_QUEUE_H
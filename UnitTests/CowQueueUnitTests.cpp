@@ -0,0 +1,243 @@
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "catch.hpp"
+#include "relativeIncludes.h"
+
+template <class T>
+std::string readCowQueue(const CowQueue<T>& q)
+{
+    std::string result;
+    for (const T& item : q)
+    {
+        result += std::to_string(item) + " ";
+    }
+    return result;
+}
+
+TEMPLATE_TEST_CASE("CowQueue int Queue", "[basics]", CowQueue<int>, (CowQueue<int, PoolAllocator<int>>))
+{
+    checkIntQueueScenario<TestType>();
+}
+
+TEST_CASE("CowQueue")
+{
+    CowQueue<int> q;
+    q.pushBack(1).pushBack(2).pushBack(3);
+
+    SECTION("Copies share the nodes")
+    {
+        CowQueue<int> copyQ(q);
+        const CowQueue<int>& constCopy = copyQ;
+        REQUIRE(q.isShared());
+        REQUIRE(&constCopy.front() == &static_cast<const CowQueue<int>&>(q).front());
+        REQUIRE(readCowQueue(constCopy) == "1 2 3 ");
+        REQUIRE(constCopy.size() == 3);
+        REQUIRE(copyQ.isShared());
+
+        CowQueue<int> assignedQ;
+        assignedQ = q;
+        REQUIRE(&assignedQ.queue() == &q.queue());
+    }
+
+    SECTION("Changes detach")
+    {
+        CowQueue<int> pushedQ(q);
+        pushedQ.pushBack(4);
+        REQUIRE_FALSE(pushedQ.isShared());
+        REQUIRE(readCowQueue(pushedQ) == "1 2 3 4 ");
+        REQUIRE(readCowQueue(q) == "1 2 3 ");
+
+        CowQueue<int> poppedQ(q);
+        poppedQ.popFront();
+        REQUIRE(poppedQ.front() == 2);
+        REQUIRE(q.queue().front() == 1);
+
+        CowQueue<int> frontQ(q);
+        frontQ.front() = 69;
+        REQUIRE(q.queue().front() == 1);
+        REQUIRE(frontQ.queue().front() == 69);
+
+        CowQueue<int> iteratedQ(q);
+        for (int& item : iteratedQ)
+        {
+            item *= 10;
+        }
+        REQUIRE(readCowQueue(iteratedQ) == "10 20 30 ");
+        REQUIRE(readCowQueue(q) == "1 2 3 ");
+
+        CowQueue<int> transformedQ(q);
+        transform(transformedQ, setSixtyNine);
+        REQUIRE(readCowQueue(transformedQ) == "69 69 69 ");
+        REQUIRE(readCowQueue(q) == "1 2 3 ");
+        REQUIRE_FALSE(q.isShared());
+
+        // A handle that is not shared changes in place
+        const int* firstItem = &q.front();
+        q.front() = 0;
+        REQUIRE(&q.front() == firstItem);
+    }
+
+    SECTION("Copies made after a reference was handed out do not share it")
+    {
+        CowQueue<int> a;
+        a.pushBack(1);
+        int& r = a.front();
+        CowQueue<int> b(a);
+        r = 42;
+        REQUIRE(b.front() == 1);
+        REQUIRE(a.queue().front() == 42);
+
+        CowQueue<int>::Iterator i = q.begin();
+        CowQueue<int> assignedQ;
+        assignedQ = q;
+        REQUIRE_FALSE(q.isShared());
+        *i = 99;
+        REQUIRE(assignedQ.queue().front() == 1);
+        REQUIRE(readCowQueue(q) == "99 2 3 ");
+
+        // Once the queue is popped empty no reference is left, and copies share again
+        a.popFront();
+        CowQueue<int> emptyCopy(a);
+        REQUIRE(a.isShared());
+    }
+
+    SECTION("Moves hand the Queue over")
+    {
+        CowQueue<CopyCounter> a;
+        a.emplaceBack(1).emplaceBack(2);
+        a.front().m_value = 10; // The handle is unshareable from here on
+        CopyCounter::copies = 0;
+
+        CowQueue<CopyCounter> b(std::move(a));
+        REQUIRE(CopyCounter::copies == 0);
+        REQUIRE(b.front().m_value == 10);
+        REQUIRE(b.size() == 2);
+        REQUIRE(a.size() == 0);
+        a.emplaceBack(3); // The moved handle is a valid empty queue
+        REQUIRE(a.front().m_value == 3);
+
+        CowQueue<CopyCounter> c;
+        c = std::move(b);
+        REQUIRE(CopyCounter::copies == 0);
+        REQUIRE(c.size() == 2);
+        REQUIRE(b.size() == 0);
+
+        // An unshareable copy made afterwards still gets items of its own
+        CowQueue<CopyCounter> d(c);
+        REQUIRE(CopyCounter::copies == 2);
+        REQUIRE(std::is_nothrow_move_constructible<CowQueue<int>>::value);
+        REQUIRE(std::is_nothrow_move_assignable<CowQueue<int>>::value);
+    }
+
+    SECTION("Empty queues")
+    {
+        CowQueue<int> empty;
+        CowQueue<int> copyQ(empty);
+        REQUIRE_THROWS_AS(copyQ.front(), CowQueue<int>::EmptyQueue);
+        REQUIRE_THROWS_AS(copyQ.popFront(), CowQueue<int>::EmptyQueue);
+        REQUIRE(copyQ.isShared());
+        copyQ.pushBack(1);
+        REQUIRE(copyQ.size() == 1);
+        REQUIRE(empty.size() == 0);
+
+        CowQueue<int> movedQ(std::move(copyQ));
+        REQUIRE(copyQ.size() == 0);
+        REQUIRE(movedQ.size() == 1);
+    }
+
+    SECTION("filter and swap")
+    {
+        Queue<int> source;
+        for (int i = 0; i < 10; i++)
+        {
+            source.pushBack(i);
+        }
+        CowQueue<int> numbersQ(std::move(source));
+        CowQueue<int> primesQ = filter(numbersQ, isPrime);
+        REQUIRE(readCowQueue(primesQ) == "2 3 5 7 ");
+        REQUIRE(numbersQ.size() == 10);
+        swap(primesQ, numbersQ);
+        REQUIRE(numbersQ.size() == 4);
+        REQUIRE(primesQ.size() == 10);
+    }
+
+    SECTION("Snapshots read on other threads")
+    {
+        CowQueue<int> shared;
+        for (int i = 0; i < 1000; i++)
+        {
+            shared.pushBack(i);
+        }
+        std::vector<std::thread> readers;
+        std::vector<long long> sums(4, 0);
+        for (int t = 0; t < 4; t++)
+        {
+            CowQueue<int> snapshot(shared);
+            readers.emplace_back([snapshot, &sums, t]() mutable
+            {
+                for (int i = 0; i < 10; i++)
+                {
+                    snapshot.pushBack(i);
+                }
+                for (const int& item : static_cast<const CowQueue<int>&>(snapshot))
+                {
+                    sums[t] += item;
+                }
+            });
+        }
+        for (int i = 0; i < 100; i++)
+        {
+            shared.popFront();
+        }
+        for (std::thread& reader : readers)
+        {
+            reader.join();
+        }
+        for (long long sum : sums)
+        {
+            REQUIRE(sum == 999 * 1000 / 2 + 45);
+        }
+        REQUIRE(shared.size() == 900);
+    }
+
+    SECTION("Handles with a pool allocator detach on other threads")
+    {
+        typedef CowQueue<int, PoolAllocator<int>> PooledCowQueue;
+        PooledCowQueue shared;
+        for (int i = 0; i < 100; i++)
+        {
+            shared.pushBack(i);
+        }
+        std::vector<std::thread> writers;
+        std::vector<std::size_t> sizes(4, 0);
+        for (int t = 0; t < 4; t++)
+        {
+            PooledCowQueue snapshot(shared);
+            writers.emplace_back([snapshot, &sizes, t]() mutable
+            {
+                // Each detached copy allocates from pools of its own
+                for (int i = 0; i < 1000; i++)
+                {
+                    snapshot.pushBack(i);
+                    snapshot.popFront();
+                }
+                sizes[t] = snapshot.size();
+            });
+        }
+        for (int i = 0; i < 1000; i++)
+        {
+            shared.pushBack(i);
+        }
+        for (std::thread& writer : writers)
+        {
+            writer.join();
+        }
+        for (std::size_t size : sizes)
+        {
+            REQUIRE(size == 100);
+        }
+        REQUIRE(shared.size() == 1100);
+    }
+}
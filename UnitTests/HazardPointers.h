@@ -0,0 +1,250 @@
+#ifndef HAZARD_POINTERS_H
+#define HAZARD_POINTERS_H
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+static const int HAZARD_SLOTS_PER_THREAD = 2;
+static const std::size_t RETIRED_SCAN_THRESHOLD = 64;
+
+/**
+ * @brief: HazardPointers class, safe memory reclamation for lock-free structures
+ *
+ * @note: before reading through a shared pointer, a thread publishes it in one of its hazard slots and checks
+ *        that it is still reachable. Memory that was unlinked is retired instead of freed, and is only freed by a
+ *        scan that finds it in no thread's hazard slots.
+ * @note: every thread gets one record of slots the first time it uses the domain, the record is given back when
+ *        the thread exits, and what the thread retired but could not free yet is handed to the other threads
+ */
+class HazardPointers {
+private:
+    struct Record {
+        std::atomic<bool> m_active;
+        std::atomic<const void*> m_slots[HAZARD_SLOTS_PER_THREAD];
+        Record* m_next;
+
+        Record() : m_active(true), m_next(nullptr) {
+            for (std::atomic<const void*>& slot : m_slots) {
+                slot.store(nullptr);
+            }
+        }
+    };
+
+    struct Retired {
+        void* m_pointer;
+        void (*m_deleter)(void*);
+    };
+
+    /** Per thread state, releases its record when the thread exits */
+    struct ThreadState {
+        Record* m_record;
+        std::vector<Retired> m_retired;
+        // Reused by every scan, so scanning does not allocate
+        std::vector<const void*> m_hazards;
+        std::vector<Retired> m_stillProtected;
+
+        ThreadState() : m_record(domain().acquireRecord()), m_retired(), m_hazards(), m_stillProtected() {
+            // Room for a whole batch up front, so retiring does not allocate between two scans
+            m_retired.reserve(RETIRED_SCAN_THRESHOLD);
+        }
+
+        ~ThreadState() {
+            domain().scan(*this);
+            domain().adoptOrphans(m_retired, true);
+            for (std::atomic<const void*>& slot : m_record->m_slots) {
+                slot.store(nullptr);
+            }
+            m_record->m_active.store(false);
+        }
+    };
+
+    std::atomic<Record*> m_records;
+    std::mutex m_orphansMutex;
+    std::vector<Retired> m_orphans;
+
+    HazardPointers() : m_records(nullptr), m_orphansMutex(), m_orphans() {}
+
+    /** The domain is only destroyed at exit, when no thread reads shared memory anymore */
+    ~HazardPointers() {
+        for (const Retired& retired : m_orphans) {
+            retired.m_deleter(retired.m_pointer);
+        }
+        Record* record = m_records.load();
+        while (record != nullptr) {
+            Record* next = record->m_next;
+            delete record;
+            record = next;
+        }
+    }
+
+    static HazardPointers& domain() {
+        static HazardPointers instance;
+        return instance;
+    }
+
+    static ThreadState& threadState() {
+        static thread_local ThreadState state;
+        return state;
+    }
+
+    /**
+     * @return: a record of hazard slots that is not used by any other thread, records are never freed
+     */
+    Record* acquireRecord() {
+        for (Record* record = m_records.load(); record != nullptr; record = record->m_next) {
+            bool expected = false;
+            if (!record->m_active.load() && record->m_active.compare_exchange_strong(expected, true)) {
+                return record;
+            }
+        }
+        Record* record = new Record();
+        Record* head = m_records.load();
+        do {
+            record->m_next = head;
+        } while (!m_records.compare_exchange_weak(head, record));
+        return record;
+    }
+
+    /**
+     * @description: swaps the retired memory of an exiting thread into the orphans, or takes the orphans over
+     * @param: retired - list of the calling thread
+     * @param: give - true to hand the list over, false to take the orphans into it
+     */
+    void adoptOrphans(std::vector<Retired>& retired, bool give) {
+        std::lock_guard<std::mutex> lock(m_orphansMutex);
+        if (give) {
+            m_orphans.insert(m_orphans.end(), retired.begin(), retired.end());
+            retired.clear();
+        }
+        else {
+            retired.insert(retired.end(), m_orphans.begin(), m_orphans.end());
+            m_orphans.clear();
+        }
+    }
+
+    /**
+     * @description: frees every retired pointer of the thread that no thread protects
+     * @param: state - of the calling thread, only the still protected pointers stay in its retired list
+     * @note: allocating throws before anything is freed, so if the scan throws the retired list is unchanged
+     */
+    void scan(ThreadState& state) {
+        std::vector<const void*>& hazards = state.m_hazards;
+        std::vector<Retired>& stillProtected = state.m_stillProtected;
+        hazards.clear();
+        stillProtected.clear();
+        stillProtected.reserve(state.m_retired.size());
+        for (Record* record = m_records.load(); record != nullptr; record = record->m_next) {
+            if (!record->m_active.load()) {
+                continue;
+            }
+            for (std::atomic<const void*>& slot : record->m_slots) {
+                const void* hazard = slot.load();
+                if (hazard != nullptr) {
+                    hazards.push_back(hazard);
+                }
+            }
+        }
+        std::sort(hazards.begin(), hazards.end());
+        for (const Retired& candidate : state.m_retired) {
+            if (std::binary_search(hazards.begin(), hazards.end(), static_cast<const void*>(candidate.m_pointer))) {
+                stillProtected.push_back(candidate);
+            }
+            else {
+                candidate.m_deleter(candidate.m_pointer);
+            }
+        }
+        state.m_retired.swap(stillProtected);
+    }
+
+    /**
+     * @description: waits until no thread protects the retired pointer, then frees it, without allocating
+     * @note: the slow path for when the retired list cannot grow, the calling thread must not protect the pointer
+     */
+    void freeWhenUnprotected(const Retired& retired) {
+        while (true) {
+            bool isProtected = false;
+            for (Record* record = m_records.load(); record != nullptr && !isProtected; record = record->m_next) {
+                if (!record->m_active.load()) {
+                    continue;
+                }
+                for (std::atomic<const void*>& slot : record->m_slots) {
+                    if (slot.load() == retired.m_pointer) {
+                        isProtected = true;
+                    }
+                }
+            }
+            if (!isProtected) {
+                retired.m_deleter(retired.m_pointer);
+                return;
+            }
+            std::this_thread::yield();
+        }
+    }
+
+public:
+    HazardPointers(const HazardPointers& other) = delete;
+    HazardPointers& operator=(const HazardPointers& other) = delete;
+
+    /**
+     * @description: publishes the pointer loaded from "source" in a hazard slot, until it loads the same value twice
+     * @param: slot - index of the hazard slot of the calling thread
+     * @param: source - shared location of the pointer
+     * @return: the pointer, which is safe to read until the slot is cleared or reused
+     */
+    template<class P>
+    static P* protect(int slot, const std::atomic<P*>& source) {
+        std::atomic<const void*>& hazard = threadState().m_record->m_slots[slot];
+        P* pointer = source.load();
+        while (true) {
+            hazard.store(pointer);
+            P* reloaded = source.load();
+            if (reloaded == pointer) {
+                return pointer;
+            }
+            pointer = reloaded;
+        }
+    }
+
+    /**
+     * @param: slot - index of the hazard slot of the calling thread to clear
+     * @note: only publishing a hazard has to be ordered before the loads that follow it, so clearing is a release
+     */
+    static void clear(int slot) {
+        threadState().m_record->m_slots[slot].store(nullptr, std::memory_order_release);
+    }
+
+    /**
+     * @description: frees the pointer once no thread protects it anymore
+     * @param: pointer - memory that is no longer reachable from the shared structure
+     * @note: never throws, so it can follow an operation that already took effect. If the retired list cannot
+     *        grow, the pointer is freed synchronously once no thread protects it, and if a scan cannot allocate,
+     *        the retired list is kept for the next one.
+     * @note: the calling thread must have used the domain before, as it does by protecting the pointer first
+     */
+    template<class P>
+    static void retire(P* pointer) noexcept {
+        ThreadState& state = threadState();
+        Retired retired = {pointer, [](void* memory) { delete static_cast<P*>(memory); }};
+        try {
+            state.m_retired.push_back(retired);
+        }
+        catch (...) {
+            domain().freeWhenUnprotected(retired);
+            return;
+        }
+        if (state.m_retired.size() >= RETIRED_SCAN_THRESHOLD) {
+            try {
+                domain().adoptOrphans(state.m_retired, false);
+                domain().scan(state);
+            }
+            catch (...) {
+                // Nothing was freed and nothing was lost, the next retire scans again
+            }
+        }
+    }
+};
+
+#endif // HAZARD_POINTERS_H
@@ -0,0 +1,291 @@
+#ifndef INTRUSIVE_QUEUE_H
+#define INTRUSIVE_QUEUE_H
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include "Queue.h"
+
+template<class T>
+class IntrusiveHook;
+
+template<class T, IntrusiveHook<T> T::*Hook>
+class IntrusiveQueue;
+
+/**
+ * @brief: IntrusiveHook class, the link an item embeds so it can be put in an IntrusiveQueue
+ * @tparam T: type of the item that embeds the hook
+ *
+ * @note: an item may embed several hooks to be in several queues at once, but in only one queue per hook
+ * @note: copying an item does not copy its place in a queue, the copy starts unlinked and an assignment keeps the
+ *        links of the item assigned to
+ */
+template<class T>
+class IntrusiveHook {
+private:
+    // The last item of a queue links to itself, so a hook is linked exactly when the pointer is not null
+    T* m_next;
+
+    template<class U, IntrusiveHook<U> U::*Hook>
+    friend class IntrusiveQueue;
+
+public:
+    /** Constructor for IntrusiveHook, unlinked */
+    IntrusiveHook() : m_next(nullptr) {}
+
+    /** Copy constructor for IntrusiveHook, the copy is unlinked */
+    IntrusiveHook(const IntrusiveHook& other) : m_next(nullptr) {}
+
+    /** Assignment operator for IntrusiveHook, the links are left as they are */
+    IntrusiveHook& operator=(const IntrusiveHook& other) {
+        return *this;
+    }
+
+    /**
+     * @return true if the item is in a queue through this hook
+     */
+    bool isLinked() const {
+        return m_next != nullptr;
+    }
+};
+
+/**
+ * @brief: IntrusiveQueue class, a queue of items owned by the caller, linked through a hook they embed
+ * @tparam T: type of the items in the queue
+ * @tparam Hook: the member of T that links the items, as in IntrusiveQueue<Timer, &Timer::m_hook>
+ *
+ * @note: pushBack and popFront only relink the items, they never allocate, copy or destroy them
+ * @note: the queue does not own its items, every item has to outlive its time in the queue. Destroying the queue
+ *        unlinks the items that are still in it.
+ */
+template<class T, IntrusiveHook<T> T::*Hook>
+class IntrusiveQueue {
+private:
+    T* m_head;
+    T* m_tail;
+    std::size_t m_size;
+
+    /**
+     * @return: the item after the given one, nullptr for the last item
+     */
+    static T* nextOf(const T* item) {
+        T* next = (item->*Hook).m_next;
+        return next == item ? nullptr : next;
+    }
+
+    /**
+     * @description: unlinks all the items, leaving the queue empty
+     */
+    void unlinkAll() {
+        while (m_head != nullptr) {
+            T* next = nextOf(m_head);
+            (m_head->*Hook).m_next = nullptr;
+            m_head = next;
+        }
+        m_tail = nullptr;
+        m_size = EMPTY;
+    }
+
+public:
+    /** Exceptions*/
+    class EmptyQueue {};
+    class AlreadyLinked {};
+
+    /** Constructor for IntrusiveQueue */
+    IntrusiveQueue() : m_head(nullptr), m_tail(nullptr), m_size(EMPTY) {}
+
+    /** An item can be linked in only one queue per hook, so queues are moved but never copied */
+    IntrusiveQueue(const IntrusiveQueue& other) = delete;
+    IntrusiveQueue& operator=(const IntrusiveQueue& other) = delete;
+
+    /** Move constructor for IntrusiveQueue, takes over the items of "other" and leaves it empty */
+    IntrusiveQueue(IntrusiveQueue&& other) noexcept :
+            m_head(other.m_head), m_tail(other.m_tail), m_size(other.m_size) {
+        other.m_head = nullptr;
+        other.m_tail = nullptr;
+        other.m_size = EMPTY;
+    }
+
+    /** Move assignment operator for IntrusiveQueue, unlinks the items of this queue and takes over those of "other" */
+    IntrusiveQueue& operator=(IntrusiveQueue&& other) noexcept {
+        if (this != &other) {
+            unlinkAll();
+            swap(other);
+        }
+        return *this;
+    }
+
+    /** Destructor for IntrusiveQueue, unlinks the items and leaves them to their owners */
+    ~IntrusiveQueue() {
+        unlinkAll();
+    }
+
+    /** swap function
+     * @param: other queue to exchange items with, in O(1)
+     */
+    void swap(IntrusiveQueue& other) noexcept {
+        std::swap(m_head, other.m_head);
+        std::swap(m_tail, other.m_tail);
+        std::swap(m_size, other.m_size);
+    }
+
+    /** pushBack function
+     * @param: item to link at the end of the queue, it stays owned by the caller
+     * @throw: AlreadyLinked if the item is already in a queue through the same hook
+     * @return reference to the queue, so we can concatenate functions
+     */
+    IntrusiveQueue& pushBack(T& toInsert) {
+        IntrusiveHook<T>& hook = toInsert.*Hook;
+        if (hook.isLinked()) {
+            throw AlreadyLinked();
+        }
+        hook.m_next = &toInsert;
+        if (m_tail == nullptr) {
+            m_head = &toInsert;
+        }
+        else {
+            (m_tail->*Hook).m_next = &toInsert;
+        }
+        m_tail = &toInsert;
+        m_size++;
+        return *this;
+    }
+
+    /**
+     * @return reference to first element of the queue
+     */
+    T& front() {
+        if (m_head == nullptr) {
+            throw EmptyQueue();
+        }
+        return *m_head;
+    }
+
+    const T& front() const {
+        if (m_head == nullptr) {
+            throw EmptyQueue();
+        }
+        return *m_head;
+    }
+
+    /**
+     * @description: unlinks the first element of the queue, which is left to its owner
+     */
+    void popFront() {
+        if (m_head == nullptr) {
+            throw EmptyQueue();
+        }
+        T* first = m_head;
+        m_head = nextOf(first);
+        (first->*Hook).m_next = nullptr;
+        if (m_head == nullptr) {
+            m_tail = nullptr;
+        }
+        m_size--;
+    }
+
+    /**
+     * @brief: iterator over the items of the queue, from the front to the back
+     * @tparam IsConst: whether the items may be changed through the iterator
+     */
+    template<bool IsConst>
+    class BasicIterator {
+    private:
+        typedef typename std::conditional<IsConst, const T, T>::type Item;
+
+        Item* m_item;
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Item* pointer;
+        typedef Item& reference;
+
+        /**Exception for invalid operation*/
+        class InvalidOperation {};
+
+        explicit BasicIterator(Item* item) : m_item(item) {}
+
+        Item& operator*() const {
+            if (m_item == nullptr) {
+                throw InvalidOperation();
+            }
+            return *m_item;
+        }
+
+        BasicIterator& operator++() {
+            if (m_item == nullptr) {
+                throw InvalidOperation();
+            }
+            m_item = nextOf(m_item);
+            return *this;
+        }
+
+        bool operator==(const BasicIterator& other) const {
+            return m_item == other.m_item;
+        }
+
+        bool operator!=(const BasicIterator& other) const {
+            return m_item != other.m_item;
+        }
+    };
+
+    typedef BasicIterator<false> Iterator;
+    typedef BasicIterator<true> ConstIterator;
+
+    Iterator begin() {
+        return Iterator(m_head);
+    }
+
+    Iterator end() {
+        return Iterator(nullptr);
+    }
+
+    ConstIterator begin() const {
+        return ConstIterator(m_head);
+    }
+
+    ConstIterator end() const {
+        return ConstIterator(nullptr);
+    }
+
+    /**
+     * @return number of elements in the queue
+     */
+    std::size_t size() const {
+        return m_size;
+    }
+};
+
+/**
+ * @description: the items of an IntrusiveQueue belong to their owners and each hook holds one place, so the items
+ *               that pass are copied into a Queue, and the IntrusiveQueue is unchanged
+ * @return: a new Queue holding copies of the items that passed the filter, in their order
+ */
+template<typename T, IntrusiveHook<T> T::*Hook, typename FUNC>
+Queue<T> filter(const IntrusiveQueue<T, Hook>& queueToFilter, FUNC filterFunction) {
+    Queue<T> newFilteredQueue;
+    for (typename IntrusiveQueue<T, Hook>::ConstIterator i = queueToFilter.begin(); i != queueToFilter.end(); ++i) {
+        if (filterFunction(*i) == true) {
+            newFilteredQueue.pushBack(*i);
+        }
+    }
+    return newFilteredQueue;
+}
+
+template<class T, IntrusiveHook<T> T::*Hook>
+void swap(IntrusiveQueue<T, Hook>& first, IntrusiveQueue<T, Hook>& second) noexcept {
+    first.swap(second);
+}
+
+template<typename T, IntrusiveHook<T> T::*Hook, typename FUNC>
+void transform(IntrusiveQueue<T, Hook>& queueToTransform, FUNC transformFunction) {
+    for (typename IntrusiveQueue<T, Hook>::Iterator i = queueToTransform.begin(); i != queueToTransform.end(); ++i) {
+        T& itemReference = *i;
+        transformFunction(itemReference);
+    }
+}
+
+#endif // INTRUSIVE_QUEUE_H
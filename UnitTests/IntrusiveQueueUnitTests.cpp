@@ -0,0 +1,155 @@
+#include <string>
+#include <utility>
+#include <vector>
+#include "catch.hpp"
+#include "relativeIncludes.h"
+
+/** An item owned by the tests, that can wait in two queues at once */
+struct TimerEvent
+{
+    int m_id;
+    IntrusiveHook<TimerEvent> m_hook;
+    IntrusiveHook<TimerEvent> m_expiredHook;
+
+    explicit TimerEvent(int id) : m_id(id) {}
+};
+
+typedef IntrusiveQueue<TimerEvent, &TimerEvent::m_hook> TimerQueue;
+typedef IntrusiveQueue<TimerEvent, &TimerEvent::m_expiredHook> ExpiredQueue;
+
+template <class QUEUE>
+std::string readIntrusiveQueue(const QUEUE& q)
+{
+    std::string result;
+    for (const TimerEvent& event : q)
+    {
+        result += std::to_string(event.m_id) + " ";
+    }
+    return result;
+}
+
+TEST_CASE("IntrusiveQueue")
+{
+    std::vector<TimerEvent> events;
+    for (int i = 0; i < 10; i++)
+    {
+        events.emplace_back(i);
+    }
+
+    SECTION("Same behavior as Queue")
+    {
+        TimerQueue q;
+        REQUIRE(q.size() == 0);
+        REQUIRE(q.begin() == q.end());
+        REQUIRE_THROWS_AS(q.front(), TimerQueue::EmptyQueue);
+        REQUIRE_THROWS_AS(q.popFront(), TimerQueue::EmptyQueue);
+
+        for (TimerEvent& event : events)
+        {
+            q.pushBack(event);
+        }
+        REQUIRE(q.size() == 10);
+        REQUIRE(&q.front() == &events[0]);
+        REQUIRE(readIntrusiveQueue(q) == "0 1 2 3 4 5 6 7 8 9 ");
+
+        q.popFront();
+        q.popFront();
+        REQUIRE(q.size() == 8);
+        REQUIRE(q.front().m_id == 2);
+        REQUIRE(!events[0].m_hook.isLinked());
+        REQUIRE(events[2].m_hook.isLinked());
+
+        // A popped item can be pushed again
+        q.pushBack(events[0]);
+        REQUIRE(readIntrusiveQueue(q) == "2 3 4 5 6 7 8 9 0 ");
+
+        while (q.size() != 0)
+        {
+            q.popFront();
+        }
+        REQUIRE(q.begin() == q.end());
+        REQUIRE_THROWS_AS(q.popFront(), TimerQueue::EmptyQueue);
+        q.pushBack(events[5]);
+        REQUIRE(q.front().m_id == 5);
+
+        TimerQueue::Iterator endIterator = q.end();
+        REQUIRE_THROWS_AS(++endIterator, TimerQueue::Iterator::InvalidOperation);
+        REQUIRE_THROWS_AS(*endIterator, TimerQueue::Iterator::InvalidOperation);
+    }
+
+    SECTION("Items are linked once per hook")
+    {
+        TimerQueue pending;
+        TimerQueue other;
+        ExpiredQueue expired;
+        pending.pushBack(events[1]);
+        REQUIRE_THROWS_AS(pending.pushBack(events[1]), TimerQueue::AlreadyLinked);
+        REQUIRE_THROWS_AS(other.pushBack(events[1]), TimerQueue::AlreadyLinked);
+        REQUIRE(pending.size() == 1);
+        REQUIRE(other.size() == 0);
+
+        expired.pushBack(events[1]);
+        expired.pushBack(events[3]);
+        pending.pushBack(events[3]);
+        REQUIRE(readIntrusiveQueue(pending) == "1 3 ");
+        REQUIRE(readIntrusiveQueue(expired) == "1 3 ");
+
+        // Copies of an item start outside of every queue
+        TimerEvent copy(events[1]);
+        REQUIRE(!copy.m_hook.isLinked());
+        copy = events[3];
+        REQUIRE(!copy.m_hook.isLinked());
+        events[1] = copy;
+        REQUIRE(events[1].m_hook.isLinked());
+        REQUIRE(readIntrusiveQueue(pending) == "3 3 ");
+    }
+
+    SECTION("Moving and destroying queues")
+    {
+        TimerEvent spare(42);
+        {
+            TimerQueue q;
+            for (TimerEvent& event : events)
+            {
+                q.pushBack(event);
+            }
+            TimerQueue moved(std::move(q));
+            REQUIRE(q.size() == 0);
+            REQUIRE(moved.size() == 10);
+            REQUIRE(readIntrusiveQueue(moved) == "0 1 2 3 4 5 6 7 8 9 ");
+
+            q.pushBack(spare);
+            q = std::move(moved);
+            REQUIRE(readIntrusiveQueue(q) == "0 1 2 3 4 5 6 7 8 9 ");
+            REQUIRE(!spare.m_hook.isLinked());
+
+            TimerQueue swapped;
+            swap(q, swapped);
+            REQUIRE(q.size() == 0);
+            REQUIRE(swapped.size() == 10);
+        }
+        for (TimerEvent& event : events)
+        {
+            REQUIRE(!event.m_hook.isLinked());
+        }
+    }
+
+    SECTION("filter and transform")
+    {
+        TimerQueue q;
+        for (TimerEvent& event : events)
+        {
+            q.pushBack(event);
+        }
+        Queue<TimerEvent> evenQ = filter(q, [](const TimerEvent& event) { return event.m_id % 2 == 0; });
+        REQUIRE(evenQ.size() == 5);
+        REQUIRE(evenQ.front().m_id == 0);
+        REQUIRE(!evenQ.front().m_hook.isLinked());
+        REQUIRE(q.size() == 10);
+
+        transform(q, [](TimerEvent& event) { event.m_id *= 10; });
+        REQUIRE(readIntrusiveQueue(q) == "0 10 20 30 40 50 60 70 80 90 ");
+        REQUIRE(events[9].m_id == 90);
+        REQUIRE(evenQ.front().m_id == 0);
+    }
+}
@@ -0,0 +1,214 @@
+#ifndef PARALLEL_QUEUE_H
+#define PARALLEL_QUEUE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "Queue.h"
+
+/**
+ * @description: runs task(chunkIndex) for every chunk on its own thread, the calling thread takes the first chunk
+ * @note: if tasks throw, the exception of the earliest chunk is rethrown after all the threads joined
+ * @note: if a thread can not be started, the threads started so far are joined and the std::system_error is rethrown
+ */
+template<typename TASK>
+void runChunks(int chunksCount, TASK task) {
+    std::vector<std::exception_ptr> errors(chunksCount);
+    std::vector<std::thread> threads;
+    threads.reserve(chunksCount);
+    try {
+        for (int chunk = 1; chunk < chunksCount; ++chunk) {
+            threads.emplace_back([&task, &errors, chunk]() {
+                try {
+                    task(chunk);
+                }
+                catch (...) {
+                    errors[chunk] = std::current_exception();
+                }
+            });
+        }
+    }
+    catch (...) {
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        throw;
+    }
+    try {
+        task(0);
+    }
+    catch (...) {
+        errors[0] = std::current_exception();
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    for (const std::exception_ptr& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+/**
+ * @return: the number of chunks to split size items between threadsCount threads, never more than the items
+ */
+inline int chunksFor(std::size_t size, int threadsCount) {
+    return size < static_cast<std::size_t>(std::max(threadsCount, 1)) ? static_cast<int>(size) : threadsCount;
+}
+
+/**
+ * @return: the number of items in the chunk, the first size % chunksCount chunks take one item more than the rest
+ */
+inline std::size_t chunkLength(std::size_t size, int chunksCount, int chunk) {
+    std::size_t chunks = static_cast<std::size_t>(chunksCount);
+    return size / chunks + (static_cast<std::size_t>(chunk) < size % chunks ? 1 : 0);
+}
+
+/**
+ * @description: splits the queue into chunks of nearly equal length, in a single walk over the nodes
+ * @param: size - number of items between begin and end
+ * @param: chunksCount - number of chunks, at most the size of the queue
+ * @return: the iterator to the first item of every chunk, and the end iterator last
+ */
+template<typename ITERATOR>
+std::vector<ITERATOR> splitIntoChunks(ITERATOR begin, ITERATOR end, std::size_t size, int chunksCount) {
+    std::vector<ITERATOR> starts;
+    starts.reserve(chunksCount + 1);
+    ITERATOR it = begin;
+    for (int chunk = 0; chunk < chunksCount; ++chunk) {
+        starts.push_back(it);
+        for (std::size_t i = chunkLength(size, chunksCount, chunk); i > 0; --i) {
+            ++it;
+        }
+    }
+    starts.push_back(end);
+    return starts;
+}
+
+/**
+ * @description: finds where every chunk of the queue starts, through the index of an indexed queue so that every
+ *               start costs fewer steps than the stride, otherwise in a single walk over the nodes
+ * @return: the iterator to the first item of every chunk, and the end iterator last
+ */
+template<typename ITERATOR, typename QUEUE>
+std::vector<ITERATOR> chunkStarts(QUEUE& queue, int chunksCount) {
+    if (!queue.isIndexed()) {
+        return splitIntoChunks(queue.begin(), queue.end(), queue.size(), chunksCount);
+    }
+    std::vector<ITERATOR> starts;
+    starts.reserve(chunksCount + 1);
+    std::size_t position = 0;
+    for (int chunk = 0; chunk < chunksCount; ++chunk) {
+        starts.push_back(queue.iteratorAt(position));
+        position += chunkLength(queue.size(), chunksCount, chunk);
+    }
+    starts.push_back(queue.end());
+    return starts;
+}
+
+/**
+ * @description: the parallel filter for allocators without state, which may be used from several threads at once
+ * @explain: Every thread copies the items of its chunk that pass into a queue of its own, built with a copy of the
+ *           allocator of the source. Those copies compare equal, so the queues are spliced one after the other in
+ *           the original order by relinking, and each item is copied once.
+ */
+template<typename T, class Alloc, typename FUNC>
+Queue<T, Alloc> filterChunks(const Queue<T, Alloc>& queueToFilter, FUNC& filterFunction, int chunksCount,
+                             std::true_type) {
+    typedef typename Queue<T, Alloc>::ConstIterator ConstIterator;
+    std::vector<ConstIterator> starts = chunkStarts<ConstIterator>(queueToFilter, chunksCount);
+    std::vector<Queue<T, Alloc>> results;
+    results.reserve(chunksCount);
+    for (int chunk = 0; chunk < chunksCount; ++chunk) {
+        results.emplace_back(queueToFilter.get_allocator());
+    }
+    runChunks(chunksCount, [&](int chunk) {
+        for (ConstIterator i = starts[chunk]; i != starts[chunk + 1]; ++i) {
+            if (filterFunction(*i) == true) {
+                results[chunk].pushBack(*i);
+            }
+        }
+    });
+    Queue<T, Alloc> newFilteredQueue(std::move(results[0]));
+    for (int chunk = 1; chunk < chunksCount; ++chunk) {
+        newFilteredQueue.splice(std::move(results[chunk]));
+    }
+    return newFilteredQueue;
+}
+
+/**
+ * @description: the parallel filter for allocators with state, such as a PoolAllocator, which are not thread safe
+ * @explain: Every thread only collects the addresses of the items of its chunk that pass. The calling thread then
+ *           copies them, in the original order, into a queue with the allocator of the source, so each item is
+ *           copied once and only one thread allocates.
+ */
+template<typename T, class Alloc, typename FUNC>
+Queue<T, Alloc> filterChunks(const Queue<T, Alloc>& queueToFilter, FUNC& filterFunction, int chunksCount,
+                             std::false_type) {
+    typedef typename Queue<T, Alloc>::ConstIterator ConstIterator;
+    std::vector<ConstIterator> starts = chunkStarts<ConstIterator>(queueToFilter, chunksCount);
+    std::vector<std::vector<const T*>> passed(chunksCount);
+    runChunks(chunksCount, [&](int chunk) {
+        for (ConstIterator i = starts[chunk]; i != starts[chunk + 1]; ++i) {
+            if (filterFunction(*i) == true) {
+                passed[chunk].push_back(&*i);
+            }
+        }
+    });
+    Queue<T, Alloc> newFilteredQueue(queueToFilter.get_allocator());
+    for (const std::vector<const T*>& items : passed) {
+        for (const T* item : items) {
+            newFilteredQueue.pushBack(*item);
+        }
+    }
+    return newFilteredQueue;
+}
+
+/**
+ * @description: filter that evaluates the predicate on several threads
+ * @param: threadsCount - number of threads to split the queue between, the calling thread being one of them
+ * @note: the predicate is called from several threads at once
+ * @note: the new queue gets the allocator of the source, as with the serial filter
+ *
+ * @return: a new queue with the items that passed, in their original order
+ */
+template<typename T, class Alloc, typename FUNC>
+Queue<T, Alloc> filter(const Queue<T, Alloc>& queueToFilter, FUNC filterFunction, int threadsCount) {
+    int chunksCount = chunksFor(queueToFilter.size(), threadsCount);
+    if (chunksCount <= 1) {
+        return filter(queueToFilter, filterFunction);
+    }
+    return filterChunks(queueToFilter, filterFunction, chunksCount, std::is_empty<Alloc>());
+}
+
+/**
+ * @description: transform that applies the function on several threads
+ * @param: threadsCount - number of threads to split the queue between, the calling thread being one of them
+ *
+ * @explain: The node chain is walked once to find where every chunk starts, then every thread applies the function
+ *           to the items of its own chunk, so no item is touched by two threads.
+ * @note: the function is called from several threads at once, the result equals the serial transform as long as
+ *        the call on one item does not depend on the others
+ */
+template<typename T, class Alloc, typename FUNC>
+void transform(Queue<T, Alloc>& queueToTransform, FUNC transformFunction, int threadsCount) {
+    typedef typename Queue<T, Alloc>::Iterator Iterator;
+    int chunksCount = chunksFor(queueToTransform.size(), threadsCount);
+    if (chunksCount <= 1) {
+        transform(queueToTransform, transformFunction);
+        return;
+    }
+    std::vector<Iterator> starts = chunkStarts<Iterator>(queueToTransform, chunksCount);
+    runChunks(chunksCount, [&](int chunk) {
+        for (Iterator i = starts[chunk]; i != starts[chunk + 1]; ++i) {
+            T& itemReference = *i;
+            transformFunction(itemReference);
+        }
+    });
+}
+
+#endif // PARALLEL_QUEUE_H
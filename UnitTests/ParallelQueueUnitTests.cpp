@@ -0,0 +1,164 @@
+#include <stdexcept>
+#include <string>
+#include "catch.hpp"
+#include "relativeIncludes.h"
+
+TEST_CASE("Parallel filter")
+{
+    Queue<int> q;
+    for (int i = 0; i < 1984; i++)
+    {
+        q.pushBack(i);
+    }
+
+    SECTION("Same result as the serial filter")
+    {
+        for (int threadsCount : {1, 2, 3, 7, 16})
+        {
+            Queue<int> primesQ = filter(q, isPrime, threadsCount);
+            REQUIRE(primesQ.size() == 299);
+            REQUIRE(primesQ.front() == 2);
+            int previous = -1;
+            bool ordered = true;
+            for (int prime : primesQ)
+            {
+                ordered = ordered && isPrime(prime) && prime > previous;
+                previous = prime;
+            }
+            REQUIRE(ordered);
+            REQUIRE(previous == 1979);
+            primesQ.pushBack(2000); // The tail follows the spliced chunks
+            REQUIRE(primesQ.size() == 300);
+        }
+    }
+
+    SECTION("Small and empty queues")
+    {
+        Queue<int> empty;
+        REQUIRE(filter(empty, isPrime, 4).size() == 0);
+
+        Queue<int> small;
+        small.pushBack(3).pushBack(4);
+        Queue<int> filtered = filter(small, isPrime, 8);
+        REQUIRE(filtered.size() == 1);
+        REQUIRE(filtered.front() == 3);
+    }
+
+    SECTION("HealthPoints")
+    {
+        Queue<HealthPoints> healthyQ;
+        for (int i = 1; i < 100; ++i)
+        {
+            healthyQ.pushBack(i);
+        }
+        Queue<HealthPoints> filterHealthQ = filter(healthyQ, [](const HealthPoints &hp)
+        {
+            return hp > 95;
+        }, 4);
+        std::string result;
+        readQueue(result, filterHealthQ);
+        REQUIRE(result == "{96(96), 97(97), 98(98), 99(99)}");
+    }
+
+    SECTION("The allocator of the source is kept")
+    {
+        typedef Queue<int, PoolAllocator<int>> PooledQueue;
+        PoolAllocator<int> pool;
+        PooledQueue pooled(pool);
+        for (int i = 0; i < 1984; i++)
+        {
+            pooled.pushBack(i);
+        }
+        for (int threadsCount : {2, 5})
+        {
+            PooledQueue primesQ = filter(pooled, isPrime, threadsCount);
+            REQUIRE(primesQ.get_allocator() == pooled.get_allocator());
+            REQUIRE(primesQ.size() == 299);
+            REQUIRE(primesQ.front() == 2);
+
+            // So the result splices into the other queues of the pool by relinking
+            const int* first = &primesQ.front();
+            PooledQueue collected(pool);
+            collected.pushBack(-1).splice(std::move(primesQ));
+            REQUIRE(&*++collected.begin() == first);
+        }
+    }
+
+    SECTION("Exceptions of the predicate reach the caller")
+    {
+        auto throwOnSeven = [](int n)
+        {
+            if (n == 1007)
+            {
+                throw std::runtime_error("seven");
+            }
+            return true;
+        };
+        REQUIRE_THROWS_AS(filter(q, throwOnSeven, 4), std::runtime_error);
+    }
+}
+
+TEST_CASE("Parallel transform")
+{
+    SECTION("Same result as the serial transform")
+    {
+        for (int threadsCount : {1, 2, 3, 7, 16})
+        {
+            Queue<int> serialQ;
+            Queue<int> parallelQ;
+            for (int i = 0; i < 1000; i++)
+            {
+                serialQ.pushBack(i * 7919);
+                parallelQ.pushBack(i * 7919);
+            }
+            auto scramble = [](int& n)
+            {
+                n = (n % 4099) * (n % 31) - 17;
+            };
+            transform(serialQ, scramble);
+            transform(parallelQ, scramble, threadsCount);
+            bool equal = true;
+            Queue<int>::Iterator serialIt = serialQ.begin();
+            for (int item : parallelQ)
+            {
+                equal = equal && item == *serialIt;
+                ++serialIt;
+            }
+            REQUIRE(equal);
+            REQUIRE(parallelQ.size() == 1000);
+        }
+    }
+
+    SECTION("Every item is transformed once")
+    {
+        Queue<int> zeroQ;
+        for (int i = 0; i < 37; i++)
+        {
+            zeroQ.pushBack(0);
+        }
+        transform(zeroQ, [](int& n) { ++n; }, 5);
+        int sum = 0;
+        for (int item : zeroQ)
+        {
+            sum += item;
+        }
+        REQUIRE(sum == 37);
+
+        Queue<int> empty;
+        transform(empty, setSixtyNine, 4);
+        REQUIRE(empty.size() == 0);
+    }
+
+    SECTION("HealthPoints")
+    {
+        Queue<HealthPoints> healthyQ;
+        healthyQ.pushBack(1).pushBack(3).pushBack(5);
+        transform(healthyQ, [](HealthPoints &hp)
+        {
+            hp -= 2;
+        }, 8);
+        std::string result;
+        readQueue(result, healthyQ);
+        REQUIRE(result == "{0(1), 1(3), 3(5)}");
+    }
+}
@@ -0,0 +1,376 @@
+#ifndef PERSISTENT_QUEUE_H
+#define PERSISTENT_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief: PersistentQueue class, an immutable queue whose versions share their nodes
+ * @tparam T: type of the items in the queue
+ *
+ * @note: pushBack and popFront leave the queue unchanged and return a new version of it, which shares all the nodes
+ *        it can with the old one. Copying a version is O(1) and every version stays valid for as long as it is kept.
+ * @note: this is the real-time queue of Okasaki. The items are kept in a lazy front list and an immutable rear list
+ *        in reverse. When the rear grows one item longer than the front, the rear is not reversed at once: a
+ *        suspended rotation is put in front, whose cells each run one step of the reversal the first time they are
+ *        read, and keep their result. Every pushBack and popFront also forces the next cell of a schedule, so the
+ *        rotation is done before the front runs out. Both are therefore O(1) in the worst case, on any version,
+ *        however many times an old version is popped again.
+ * @note: nothing is changed after it was published, except for the suspended cells, which are forced once behind
+ *        an atomic state, so any number of threads may read and derive versions at the same time
+ */
+template<class T>
+class PersistentQueue {
+private:
+    struct Cell;
+    struct SuspendedCell;
+    typedef std::shared_ptr<const Cell> CellPointer;
+
+    /** The states of a cell, only the suspended cells are ever in the first two */
+    enum CellState {
+        CELL_SUSPENDED,
+        CELL_FORCING,
+        CELL_FORCED
+    };
+
+    /**
+     * @brief: Cell, a cell of one of the lists
+     * @note: most cells hold their item from the start. The cells a rotation builds are SuspendedCells, which hold
+     *        the arguments of their step of the rotation until they are first read.
+     */
+    struct Cell {
+        mutable typename std::aligned_storage<sizeof(T), alignof(T)>::type m_item;
+        mutable CellPointer m_next;
+        mutable std::atomic<int> m_state;
+        const bool m_suspended;
+
+        template<class U>
+        Cell(U&& item, CellPointer next) : m_next(std::move(next)), m_state(CELL_FORCED), m_suspended(false) {
+            new (&m_item) T(std::forward<U>(item));
+        }
+
+        Cell(const Cell& other) = delete;
+        Cell& operator=(const Cell& other) = delete;
+
+        /**
+         * @description: Destructor for Cell
+         * @note: the cells that die with this one are released in a loop, a recursive release of a long list would
+         *        overflow the stack
+         */
+        ~Cell() {
+            if (m_state.load(std::memory_order_relaxed) == CELL_FORCED) {
+                reinterpret_cast<T*>(&m_item)->~T();
+            }
+            releaseChain(std::move(m_next));
+        }
+
+        const T& item() const {
+            force();
+            return *reinterpret_cast<const T*>(&m_item);
+        }
+
+        const CellPointer& next() const {
+            force();
+            return m_next;
+        }
+
+        /**
+         * @description: runs the step of the rotation of a suspended cell, once, other threads reading the cell
+         *               meanwhile wait for it
+         * @note: if copying an item throws, the cell stays suspended and the next read tries again
+         */
+        void force() const {
+            if (m_state.load(std::memory_order_acquire) == CELL_FORCED) {
+                return;
+            }
+            int expected = CELL_SUSPENDED;
+            while (!m_state.compare_exchange_weak(expected, CELL_FORCING, std::memory_order_acquire)) {
+                if (expected == CELL_FORCED) {
+                    return;
+                }
+                expected = CELL_SUSPENDED;
+                std::this_thread::yield();
+            }
+            try {
+                static_cast<const SuspendedCell*>(this)->rotate();
+            }
+            catch (...) {
+                m_state.store(CELL_SUSPENDED, std::memory_order_release);
+                throw;
+            }
+            m_state.store(CELL_FORCED, std::memory_order_release);
+        }
+
+    protected:
+        /** Constructor for a suspended Cell */
+        Cell() : m_next(), m_state(CELL_SUSPENDED), m_suspended(true) {}
+    };
+
+    /**
+     * @brief: SuspendedCell, a cell of the front that will be the next step of a rotation, whose result is
+     *         front ++ reverse(rear) ++ accumulated
+     */
+    struct SuspendedCell : Cell {
+        mutable CellPointer m_front;
+        mutable CellPointer m_rear;
+        mutable CellPointer m_accumulated;
+
+        SuspendedCell(CellPointer front, CellPointer rear, CellPointer accumulated) :
+                Cell(), m_front(std::move(front)), m_rear(std::move(rear)), m_accumulated(std::move(accumulated)) {}
+
+        ~SuspendedCell() {
+            releaseArguments();
+        }
+
+        /**
+         * @description: the first item of front followed by rotate(rest of front, rest of rear, first item of
+         *               rear :: accumulated), and for the last step, with the front empty, the only item left in the
+         *               rear followed by accumulated
+         */
+        void rotate() const {
+            const Cell& rear = *m_rear;
+            if (m_front == nullptr) {
+                new (&this->m_item) T(rear.item());
+                this->m_next = m_accumulated;
+            }
+            else {
+                const Cell& front = *m_front;
+                CellPointer accumulated = std::make_shared<Cell>(rear.item(), m_accumulated);
+                CellPointer next = std::make_shared<SuspendedCell>(front.next(), rear.next(), std::move(accumulated));
+                new (&this->m_item) T(front.item());
+                this->m_next = std::move(next);
+            }
+            releaseArguments();
+        }
+
+        /**
+         * @note: the arguments of a rotation are fully forced lists, so releasing them goes no deeper than this
+         */
+        void releaseArguments() const {
+            releaseChain(std::move(m_front));
+            releaseChain(std::move(m_rear));
+            releaseChain(std::move(m_accumulated));
+        }
+    };
+
+    /**
+     * @description: releases a list, the cells that are not shared are destroyed one after the other
+     */
+    static void releaseChain(CellPointer chain) {
+        while (chain != nullptr && chain.use_count() == 1) {
+            // The other owners may have just been released on other threads, their reads come before our writes
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const Cell& cell = *chain;
+            CellPointer next = std::move(cell.m_next);
+            if (cell.m_suspended) {
+                static_cast<const SuspendedCell&>(cell).releaseArguments();
+            }
+            chain = std::move(next);
+        }
+    }
+
+    CellPointer m_front;
+    CellPointer m_rear;
+    CellPointer m_schedule;
+    std::size_t m_frontSize;
+    std::size_t m_rearSize;
+
+    PersistentQueue(CellPointer front, std::size_t frontSize, CellPointer rear, std::size_t rearSize,
+                    CellPointer schedule) :
+            m_front(std::move(front)), m_rear(std::move(rear)), m_schedule(std::move(schedule)),
+            m_frontSize(frontSize), m_rearSize(rearSize) {}
+
+    /**
+     * @description: the version after a change, the schedule holds the suffix of the front that is not forced yet,
+     *               as many cells as the front is longer than the rear
+     * @return: the version with the next cell of the schedule forced, or, when the schedule ran out because the rear
+     *          became one longer than the front, with a suspended rotation of the rear into a new front
+     */
+    static PersistentQueue balanced(CellPointer front, std::size_t frontSize, CellPointer rear, std::size_t rearSize,
+                                    const CellPointer& schedule) {
+        if (schedule != nullptr) {
+            return PersistentQueue(std::move(front), frontSize, std::move(rear), rearSize, schedule->next());
+        }
+        CellPointer rotated = std::make_shared<SuspendedCell>(std::move(front), std::move(rear), nullptr);
+        return PersistentQueue(rotated, frontSize + rearSize, nullptr, 0, rotated);
+    }
+
+public:
+    /** Exceptions*/
+    class EmptyQueue {};
+
+    /**
+     * @brief: ConstIterator class, walks the front list and then the rear list backwards
+     * @note: the iterator points into the version it came from, which must outlive it
+     * @note: begin() collects the rear cells into a vector, so iterating a version allocates once if it has a rear
+     */
+    class ConstIterator {
+    private:
+        const Cell* m_cell;
+        std::shared_ptr<std::vector<const Cell*>> m_rearCells;
+        std::size_t m_rearIndex;
+
+        friend class PersistentQueue;
+
+        ConstIterator(const Cell* cell, std::shared_ptr<std::vector<const Cell*>> rearCells, std::size_t rearIndex) :
+                m_cell(cell), m_rearCells(std::move(rearCells)), m_rearIndex(rearIndex) {}
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const T* pointer;
+        typedef const T& reference;
+
+        /**Exception for invalid operation*/
+        class InvalidOperation {};
+
+        const T& operator*() const {
+            if (m_cell != nullptr) {
+                return m_cell->item();
+            }
+            if (m_rearCells == nullptr || m_rearIndex >= m_rearCells->size()) {
+                throw InvalidOperation();
+            }
+            return (*m_rearCells)[m_rearIndex]->item();
+        }
+
+        ConstIterator& operator++() {
+            if (m_cell != nullptr) {
+                m_cell = m_cell->next().get();
+            }
+            else if (m_rearCells != nullptr && m_rearIndex < m_rearCells->size()) {
+                ++m_rearIndex;
+            }
+            else {
+                throw InvalidOperation();
+            }
+            return *this;
+        }
+
+        bool operator==(const ConstIterator& other) const {
+            return m_cell == other.m_cell && m_rearIndex == other.m_rearIndex;
+        }
+
+        bool operator!=(const ConstIterator& other) const {
+            return !(*this == other);
+        }
+    };
+
+    /** Constructor for PersistentQueue, the empty version */
+    PersistentQueue() : m_front(), m_rear(), m_schedule(), m_frontSize(0), m_rearSize(0) {}
+
+    /**
+     * @description: builds a version holding the items of a range, in order
+     * @param: first, last - range of items to copy
+     * @return: the new version
+     */
+    template<class InputIterator>
+    static PersistentQueue fromRange(InputIterator first, InputIterator last) {
+        PersistentQueue result;
+        for (; first != last; ++first) {
+            result = result.pushBack(*first);
+        }
+        return result;
+    }
+
+    /** pushBack function
+     * @param: item to insert, it is copied
+     * @return: a new version with the item at its end, this version is unchanged
+     */
+    PersistentQueue pushBack(const T& toInsert) const {
+        return balanced(m_front, m_frontSize, std::make_shared<Cell>(toInsert, m_rear), m_rearSize + 1, m_schedule);
+    }
+
+    /** pushBack function for temporaries
+     * @param: item to move into the new version
+     * @return: a new version with the item at its end, this version is unchanged
+     */
+    PersistentQueue pushBack(T&& toInsert) const {
+        return balanced(m_front, m_frontSize, std::make_shared<Cell>(std::move(toInsert), m_rear), m_rearSize + 1,
+                        m_schedule);
+    }
+
+    /**
+     * @return: a new version without the first item, this version is unchanged
+     * @throw: EmptyQueue if the queue is empty
+     */
+    PersistentQueue popFront() const {
+        if (m_front == nullptr) {
+            throw EmptyQueue();
+        }
+        return balanced(m_front->next(), m_frontSize - 1, m_rear, m_rearSize, m_schedule);
+    }
+
+    /**
+     * @return: reference to the first item, valid for as long as a version holding it is kept
+     * @throw: EmptyQueue if the queue is empty
+     */
+    const T& front() const {
+        if (m_front == nullptr) {
+            throw EmptyQueue();
+        }
+        return m_front->item();
+    }
+
+    ConstIterator begin() const {
+        if (m_rear == nullptr) {
+            return ConstIterator(m_front.get(), nullptr, 0);
+        }
+        std::shared_ptr<std::vector<const Cell*>> rearCells = std::make_shared<std::vector<const Cell*>>(m_rearSize);
+        std::size_t index = m_rearSize;
+        for (const Cell* cell = m_rear.get(); cell != nullptr; cell = cell->next().get()) {
+            (*rearCells)[--index] = cell;
+        }
+        return ConstIterator(m_front.get(), std::move(rearCells), 0);
+    }
+
+    ConstIterator end() const {
+        return ConstIterator(nullptr, nullptr, m_rearSize);
+    }
+
+    /**
+     * @return number of items in the queue
+     */
+    std::size_t size() const {
+        return m_frontSize + m_rearSize;
+    }
+};
+
+/**
+ * @return: a new version holding the items of the queue that pass the filter, in their order
+ */
+template<typename T, typename FUNC>
+PersistentQueue<T> filter(const PersistentQueue<T>& queueToFilter, FUNC filterFunction) {
+    PersistentQueue<T> newFilteredQueue;
+    for (typename PersistentQueue<T>::ConstIterator i = queueToFilter.begin(); i != queueToFilter.end(); ++i) {
+        if (filterFunction(*i) == true) {
+            newFilteredQueue = newFilteredQueue.pushBack(*i);
+        }
+    }
+    return newFilteredQueue;
+}
+
+/**
+ * @description: the items of a version can not change, so the function is applied to copies of them
+ * @return: a new version holding the transformed copies, the original version is unchanged
+ */
+template<typename T, typename FUNC>
+PersistentQueue<T> transform(const PersistentQueue<T>& queueToTransform, FUNC transformFunction) {
+    PersistentQueue<T> newTransformedQueue;
+    for (typename PersistentQueue<T>::ConstIterator i = queueToTransform.begin(); i != queueToTransform.end(); ++i) {
+        T item(*i);
+        transformFunction(item);
+        newTransformedQueue = newTransformedQueue.pushBack(std::move(item));
+    }
+    return newTransformedQueue;
+}
+
+#endif // PERSISTENT_QUEUE_H
@@ -0,0 +1,170 @@
+#include <string>
+#include <thread>
+#include <vector>
+#include "catch.hpp"
+#include "relativeIncludes.h"
+
+template <class T>
+std::string readPersistentQueue(const PersistentQueue<T>& q)
+{
+    std::string result;
+    for (const T& item : q)
+    {
+        using std::to_string;
+        result += to_string(item) + " ";
+    }
+    return result;
+}
+
+TEST_CASE("PersistentQueue")
+{
+    SECTION("Versions are unchanged")
+    {
+        PersistentQueue<int> empty;
+        PersistentQueue<int> one = empty.pushBack(1);
+        PersistentQueue<int> two = one.pushBack(2);
+        PersistentQueue<int> three = two.pushBack(3);
+        PersistentQueue<int> popped = three.popFront();
+        PersistentQueue<int> branch = two.pushBack(20);
+
+        REQUIRE(empty.size() == 0);
+        REQUIRE_THROWS_AS(empty.front(), PersistentQueue<int>::EmptyQueue);
+        REQUIRE_THROWS_AS(empty.popFront(), PersistentQueue<int>::EmptyQueue);
+        REQUIRE(readPersistentQueue(one) == "1 ");
+        REQUIRE(readPersistentQueue(two) == "1 2 ");
+        REQUIRE(readPersistentQueue(three) == "1 2 3 ");
+        REQUIRE(readPersistentQueue(popped) == "2 3 ");
+        REQUIRE(readPersistentQueue(branch) == "1 2 20 ");
+        REQUIRE(popped.front() == 2);
+        REQUIRE(popped.size() == 2);
+        REQUIRE(three.front() == 1);
+        REQUIRE(three.size() == 3);
+    }
+
+    SECTION("Same behavior as Queue")
+    {
+        Queue<int> q;
+        PersistentQueue<int> p;
+        std::vector<PersistentQueue<int>> history;
+        for (int i = 0; i < 2000; i++)
+        {
+            q.pushBack(i);
+            p = p.pushBack(i);
+            if (i % 3 == 0)
+            {
+                q.popFront();
+                p = p.popFront();
+            }
+            history.push_back(p);
+        }
+        REQUIRE(p.size() == q.size());
+        REQUIRE(p.front() == q.front());
+        Queue<int>::Iterator expected = q.begin();
+        bool same = true;
+        for (int item : p)
+        {
+            same = same && item == *expected;
+            ++expected;
+        }
+        REQUIRE(same);
+
+        // Every version kept still holds what it held
+        REQUIRE(history[0].size() == 0);
+        REQUIRE(history[1].size() == 1);
+        REQUIRE(history[1].front() == 1);
+        REQUIRE(history[999].size() == 666);
+        REQUIRE(history[999].front() == 334);
+    }
+
+    SECTION("filter and transform")
+    {
+        std::vector<int> numbers;
+        for (int i = 0; i < 1984; i++)
+        {
+            numbers.push_back(i);
+        }
+        PersistentQueue<int> p = PersistentQueue<int>::fromRange(numbers.begin(), numbers.end());
+        PersistentQueue<int> primes = filter(p, isPrime);
+        REQUIRE(primes.size() == 299);
+        REQUIRE(primes.front() == 2);
+
+        PersistentQueue<int> sixtyNines = transform(primes, setSixtyNine);
+        REQUIRE(sixtyNines.size() == 299);
+        REQUIRE(sixtyNines.front() == 69);
+        REQUIRE(primes.front() == 2);
+    }
+
+    SECTION("Old versions pop in constant time")
+    {
+        CopyCounter::copies = 0;
+        PersistentQueue<CopyCounter> p;
+        for (int i = 0; i < 10000; i++)
+        {
+            p = p.pushBack(CopyCounter(i));
+        }
+        PersistentQueue<CopyCounter> old = p;
+        for (int i = 0; i < 5000; i++)
+        {
+            p = p.popFront();
+        }
+        REQUIRE(p.front().m_value == 5000);
+
+        // Popping the same old version again does not reverse its rear again
+        CopyCounter::copies = 0;
+        for (int i = 0; i < 1000; i++)
+        {
+            REQUIRE(old.popFront().front().m_value == 1);
+            REQUIRE(old.pushBack(CopyCounter(-1)).size() == 10001);
+        }
+        REQUIRE(CopyCounter::copies <= 4 * 1000);
+        REQUIRE(readPersistentQueue(filter(old, [](const CopyCounter& c) { return c.m_value < 3; })) == "0 1 2 ");
+    }
+
+    SECTION("Long histories are released")
+    {
+        PersistentQueue<int> p;
+        for (int i = 0; i < 1000000; i++)
+        {
+            p = p.pushBack(i);
+        }
+        p = p.popFront();
+        REQUIRE(p.size() == 999999);
+        p = PersistentQueue<int>();
+        REQUIRE(p.size() == 0);
+    }
+
+    SECTION("Versions read and derived on other threads")
+    {
+        PersistentQueue<int> shared;
+        for (int i = 0; i < 1000; i++)
+        {
+            shared = shared.pushBack(i);
+        }
+        std::vector<std::thread> readers;
+        std::vector<long long> sums(4, 0);
+        for (int t = 0; t < 4; t++)
+        {
+            readers.emplace_back([shared, &sums, t]()
+            {
+                PersistentQueue<int> mine = shared.popFront().pushBack(t);
+                for (int item : mine)
+                {
+                    sums[t] += item;
+                }
+            });
+        }
+        for (int i = 0; i < 500; i++)
+        {
+            shared = shared.popFront();
+        }
+        for (std::thread& reader : readers)
+        {
+            reader.join();
+        }
+        for (int t = 0; t < 4; t++)
+        {
+            REQUIRE(sums[t] == 999 * 1000 / 2 + t);
+        }
+        REQUIRE(shared.front() == 500);
+    }
+}
@@ -0,0 +1,267 @@
+#ifndef POOL_ALLOCATOR_H
+#define POOL_ALLOCATOR_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+static const std::size_t DEFAULT_CHUNKS_PER_BLOCK = 256;
+
+/**
+ * @brief: MemoryPool class, hands out fixed-size chunks carved from large blocks
+ *
+ * @note: freed chunks are kept on a free list and handed out again before a new block is allocated,
+ *        blocks are only given back to the system when the pool is destroyed
+ * @note: the pool is not thread safe
+ */
+class MemoryPool {
+private:
+    struct FreeChunk {
+        FreeChunk* m_next;
+    };
+
+    std::size_t m_chunkSize;
+    std::size_t m_chunksPerBlock;
+    FreeChunk* m_freeList;
+    std::vector<void*> m_blocks;
+
+    /**
+     * @description: allocates a new block and threads all of its chunks onto the free list
+     */
+    void addBlock() {
+        // Room for the pointer is made first so push_back can not throw, and it grows geometrically, reserving
+        // exactly one more would copy the whole list on every block
+        if (m_blocks.size() == m_blocks.capacity()) {
+            m_blocks.reserve(2 * m_blocks.size() + 1);
+        }
+        char* block = static_cast<char*>(::operator new(m_chunkSize * m_chunksPerBlock));
+        m_blocks.push_back(block);
+        for (std::size_t i = m_chunksPerBlock; i > 0; --i) {
+            FreeChunk* chunk = reinterpret_cast<FreeChunk*>(block + (i - 1) * m_chunkSize);
+            chunk->m_next = m_freeList;
+            m_freeList = chunk;
+        }
+    }
+
+public:
+    /**
+     * @description: Constructor for MemoryPool, no memory is allocated until the first chunk is requested
+     * @param: chunkSize - size of each chunk, rounded up so every chunk can hold the free list link
+     * @param: chunksPerBlock - number of chunks carved out of every block
+     */
+    MemoryPool(std::size_t chunkSize, std::size_t chunksPerBlock) :
+            m_chunkSize(chunkSizeFor(chunkSize)),
+            m_chunksPerBlock(chunksPerBlock == 0 ? 1 : chunksPerBlock), m_freeList(nullptr), m_blocks() {}
+
+    /** A pool owns its blocks, so it is never copied */
+    MemoryPool(const MemoryPool& other) = delete;
+    MemoryPool& operator=(const MemoryPool& other) = delete;
+
+    /** Destructor for MemoryPool, gives all the blocks back to the system */
+    ~MemoryPool() {
+        for (void* block : m_blocks) {
+            ::operator delete(block);
+        }
+    }
+
+    /**
+     * @return: a chunk of memory, taken from the free list or from a new block
+     * @throw: std::bad_alloc if a new block could not be allocated
+     */
+    void* allocate() {
+        if (m_freeList == nullptr) {
+            addBlock();
+        }
+        FreeChunk* chunk = m_freeList;
+        m_freeList = chunk->m_next;
+        return chunk;
+    }
+
+    /**
+     * @param: chunk previously handed out by this pool, which goes back to the free list
+     */
+    void deallocate(void* chunk) {
+        FreeChunk* freed = static_cast<FreeChunk*>(chunk);
+        freed->m_next = m_freeList;
+        m_freeList = freed;
+    }
+
+    /**
+     * @return: size of every chunk handed out by the pool
+     */
+    std::size_t chunkSize() const {
+        return m_chunkSize;
+    }
+
+    /**
+     * @return: number of blocks allocated so far
+     */
+    std::size_t blockCount() const {
+        return m_blocks.size();
+    }
+
+    static std::size_t roundUp(std::size_t size, std::size_t alignment) {
+        return (size + alignment - 1) / alignment * alignment;
+    }
+
+    /**
+     * @return: size of the chunks of a pool asked for chunks of "size" bytes
+     */
+    static std::size_t chunkSizeFor(std::size_t size) {
+        return roundUp(size < sizeof(FreeChunk) ? sizeof(FreeChunk) : size, alignof(FreeChunk));
+    }
+};
+
+/**
+ * @brief: PoolSet class, one MemoryPool per chunk size, so allocators of different types can share a set
+ *
+ * @note: a pool is created the first time a chunk of its size is requested, and lives as long as the set
+ * @note: the set is not thread safe
+ */
+class PoolSet {
+private:
+    std::size_t m_chunksPerBlock;
+    std::vector<std::unique_ptr<MemoryPool>> m_pools;
+
+public:
+    /**
+     * @param: chunksPerBlock - number of chunks carved out of every block of every pool
+     */
+    explicit PoolSet(std::size_t chunksPerBlock) : m_chunksPerBlock(chunksPerBlock), m_pools() {}
+
+    PoolSet(const PoolSet& other) = delete;
+    PoolSet& operator=(const PoolSet& other) = delete;
+
+    /**
+     * @param: size - size of the objects the pool hands out
+     * @return: the pool of the set for objects of that size, created if there is none yet
+     * @throw: std::bad_alloc if a new pool could not be created
+     */
+    MemoryPool& poolFor(std::size_t size) {
+        std::size_t chunkSize = MemoryPool::chunkSizeFor(size);
+        // A set only ever holds a few sizes, a node type and the types it was rebound to
+        for (const std::unique_ptr<MemoryPool>& pool : m_pools) {
+            if (pool->chunkSize() == chunkSize) {
+                return *pool;
+            }
+        }
+        std::unique_ptr<MemoryPool> pool(new MemoryPool(chunkSize, m_chunksPerBlock));
+        m_pools.push_back(std::move(pool));
+        return *m_pools.back();
+    }
+
+    /**
+     * @return: number of blocks allocated so far by all the pools of the set
+     */
+    std::size_t blockCount() const {
+        std::size_t count = 0;
+        for (const std::unique_ptr<MemoryPool>& pool : m_pools) {
+            count += pool->blockCount();
+        }
+        return count;
+    }
+};
+
+/**
+ * @brief: PoolAllocator class, an allocator that serves single objects from a MemoryPool
+ * @tparam T: type of the allocated objects
+ * @tparam ChunksPerBlock: number of objects carved out of every block of the pool
+ *
+ * @note: copies of an allocator and allocators rebound from it share its PoolSet, each type takes its chunks from
+ *        the pool of its size. So a Queue built from a PoolAllocator<T> allocates its nodes from the pools of that
+ *        allocator, and compares equal to it.
+ * @note: a PoolSet is not thread safe, so a copy of a container starts with a new PoolSet of its own, and the copy
+ *        may be used on another thread than the original
+ * @note: requests for more than one object at a time bypass the pool
+ */
+template<class T, std::size_t ChunksPerBlock = DEFAULT_CHUNKS_PER_BLOCK>
+class PoolAllocator {
+private:
+    std::shared_ptr<PoolSet> m_pools;
+    // The pool of the set for T, looked up on the first allocation
+    MemoryPool* m_pool;
+
+    template<class U, std::size_t N>
+    friend class PoolAllocator;
+
+    MemoryPool& pool() {
+        if (m_pool == nullptr) {
+            m_pool = &m_pools->poolFor(MemoryPool::roundUp(sizeof(T), alignof(T)));
+        }
+        return *m_pool;
+    }
+
+public:
+    typedef T value_type;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    template<class U>
+    struct rebind {
+        typedef PoolAllocator<U, ChunksPerBlock> other;
+    };
+
+    /** Constructor for PoolAllocator, with a new empty set of pools */
+    PoolAllocator() : m_pools(std::make_shared<PoolSet>(ChunksPerBlock)), m_pool(nullptr) {}
+
+    /** Copy constructor for PoolAllocator, the copy shares the pool */
+    PoolAllocator(const PoolAllocator& other) = default;
+    PoolAllocator& operator=(const PoolAllocator& other) = default;
+
+    /**
+     * @return: the allocator of a copy of a container, with a new empty set of pools
+     */
+    PoolAllocator select_on_container_copy_construction() const {
+        return PoolAllocator();
+    }
+
+    /** Rebinding constructor for PoolAllocator, shares the set of pools, so PoolAllocator<U>(a) == a */
+    template<class U>
+    explicit PoolAllocator(const PoolAllocator<U, ChunksPerBlock>& other) noexcept :
+            m_pools(other.m_pools), m_pool(nullptr) {}
+
+    /**
+     * @param: count - number of objects to allocate memory for
+     * @return: pointer to uninitialized memory for "count" objects
+     */
+    T* allocate(std::size_t count) {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "PoolAllocator does not support over-aligned types");
+        if (count != 1) {
+            return static_cast<T*>(::operator new(count * sizeof(T)));
+        }
+        return static_cast<T*>(pool().allocate());
+    }
+
+    /**
+     * @param: pointer - memory returned by allocate()
+     * @param: count - the number of objects it was allocated for
+     */
+    void deallocate(T* pointer, std::size_t count) {
+        if (count != 1) {
+            ::operator delete(pointer);
+            return;
+        }
+        pool().deallocate(pointer);
+    }
+
+    /**
+     * @return: number of blocks the pools of this allocator allocated so far, for every type it was rebound to
+     */
+    std::size_t blockCount() const {
+        return m_pools->blockCount();
+    }
+
+    template<class U>
+    bool operator==(const PoolAllocator<U, ChunksPerBlock>& other) const {
+        return m_pools == other.m_pools;
+    }
+
+    template<class U>
+    bool operator!=(const PoolAllocator<U, ChunksPerBlock>& other) const {
+        return !(*this == other);
+    }
+};
+
+#endif // POOL_ALLOCATOR_H
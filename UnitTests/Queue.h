@@ -1,20 +1,30 @@
 #ifndef QUEUE_H
 #define QUEUE_H
 
+#include <cstddef>
+#include <initializer_list>
 #include <iostream>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 static const int EMPTY = 0;
+static const int DEFAULT_INDEX_STRIDE = 64;
 
 /**
  * @brief: Queue class
  * @tparam T: type of the items in the queue
+ * @tparam Alloc: allocator for the items, rebound through std::allocator_traits to allocate the nodes
  */
-template<class T>
+template<class T, class Alloc = std::allocator<T>>
 class Queue {
 private:
     class Node {
     private:
-        T* m_item;
+        // The item is stored inside the node itself, so each item costs a single allocation
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type m_item;
         Node* m_next;
 
     public:
@@ -22,41 +32,32 @@ private:
          * @description: Constructor for Node
          * @param: item to insert to the node
          * @note: the item is copied, not inserted itself into the node
+         * @note: the copy is constructed in place inside the node, if it throws the node is never constructed
          * @return: Node
          */
         explicit Node(const T& item) : m_next(nullptr) {
-            T* newItem = new T(item);
-            m_item = newItem;
+            new (&m_item) T(item);
         }
 
         /**
-         * @description: Copy Constructor for Node
-         * @param: other node to copy
+         * @description: Constructor for Node that builds the item in place
+         * @param: arguments forwarded to the constructor of the item
          * @return: Node
          */
-        Node(const Node &other) : m_item(new T(*other.m_item)), m_next(other.m_next) {}
-
-        /**
-         * @description: Assignment operator for Node
-         * @param: other node to copy
-         * @return: Node
-         */
-        Node& operator=(const Node &other) {
-            if (this != &other) {
-                delete m_item;
-                m_item = new T(nodeGetItem(other));
-                m_next = getNext(other);
-            }
-            return *this;
+        template<class... Args>
+        explicit Node(Args&&... args) : m_next(nullptr) {
+            new (&m_item) T(std::forward<Args>(args)...);
         }
 
+        /** Nodes own their item and are only linked by the queue, so they are never copied */
+        Node(const Node &other) = delete;
+        Node& operator=(const Node &other) = delete;
+
         /**
-         * @description: Destructor for Node, deletes the item
+         * @description: Destructor for Node, destroys the item
          */
         ~Node() {
-            if(m_item != nullptr) {
-                delete m_item;
-            }
+            getReferenceToItem().~T();
         }
 
         /** Getters */
@@ -66,8 +67,12 @@ private:
          * @param: node
          * @return: item of the node
          */
-        T& getReferenceToItem() const {
-            return *m_item;
+        T& getReferenceToItem() {
+            return *reinterpret_cast<T*>(&m_item);
+        }
+
+        const T& getReferenceToItem() const {
+            return *reinterpret_cast<const T*>(&m_item);
         }
 
         /**
@@ -86,33 +91,305 @@ private:
         }
     };
 
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<Node> NodeAllocator;
+    typedef std::allocator_traits<NodeAllocator> NodeTraits;
+
+    /** Jump pointers of the indexed mode, to the nodes at positions m_firstPosition, m_firstPosition + m_stride... */
+    struct PositionIndex {
+        // The first m_dropped checkpoints belong to popped nodes, they are erased once they are half of the vector
+        std::vector<Node*> m_checkpoints;
+        std::size_t m_dropped;
+        std::size_t m_stride;
+        std::size_t m_firstPosition;
+        // False only after the index failed to allocate, positions are then found by walking from the head
+        bool m_valid;
+
+        explicit PositionIndex(std::size_t stride) :
+                m_checkpoints(), m_dropped(0), m_stride(stride), m_firstPosition(0), m_valid(true) {}
+
+        std::size_t size() const {
+            return m_checkpoints.size() - m_dropped;
+        }
+
+        Node* checkpoint(std::size_t index) const {
+            return m_checkpoints[m_dropped + index];
+        }
+
+        /** Drops the first checkpoint in amortized O(1), erasing never moves more pointers than were dropped */
+        void popFront() {
+            m_dropped++;
+            if (m_dropped * 2 >= m_checkpoints.size()) {
+                m_checkpoints.erase(m_checkpoints.begin(), m_checkpoints.begin() + m_dropped);
+                m_dropped = 0;
+            }
+        }
+
+        /** Drops every checkpoint and gives their memory back */
+        void clear() {
+            std::vector<Node*>().swap(m_checkpoints);
+            m_dropped = 0;
+        }
+    };
+
     Node *m_head;
-    int m_size;
+    Node *m_tail;
+    std::size_t m_size;
+    NodeAllocator m_allocator;
+    std::unique_ptr<PositionIndex> m_index;
+
+    /**
+     * @description: allocates a node with the allocator of the queue and constructs its item in place
+     * @param: arguments forwarded to the constructor of the node
+     * @note: if the construction throws, the memory is given back and the exception is rethrown
+     * @return: the new node
+     */
+    template<class... Args>
+    Node* createNode(Args&&... args) {
+        Node* node = NodeTraits::allocate(m_allocator, 1);
+        try {
+            NodeTraits::construct(m_allocator, node, std::forward<Args>(args)...);
+        }
+        catch (...) {
+            NodeTraits::deallocate(m_allocator, node, 1);
+            throw;
+        }
+        return node;
+    }
+
+    /**
+     * @description: destroys the item of the node and gives its memory back to the allocator of the queue
+     * @param: node to destroy
+     */
+    void destroyNode(Node* node) {
+        NodeTraits::destroy(m_allocator, node);
+        NodeTraits::deallocate(m_allocator, node, 1);
+    }
+
+    /**
+     * @description: links a chain of nodes after the last node of the queue in O(1)
+     * @param: first, last - first and last nodes of a null terminated chain
+     * @param: count - number of nodes in the chain
+     */
+    void linkBack(Node* first, Node* last, std::size_t count) {
+        std::size_t firstPosition = m_size;
+        if (m_size == EMPTY) {
+            m_head = first;
+        }
+        else {
+            m_tail->setPointerToNext(first);
+        }
+        m_tail = last;
+        m_size += count;
+        indexLinked(first, firstPosition);
+    }
+
+    /**
+     * @description: adds the checkpoints that fall in a chain just linked at the back to the index
+     * @param: first - first node of the chain
+     * @param: firstPosition - position of that node in the queue
+     * @note: the queue is already changed, so if the index can not grow it is marked invalid instead of throwing
+     */
+    void indexLinked(Node* first, std::size_t firstPosition) {
+        if (m_index == nullptr || !m_index->m_valid) {
+            return;
+        }
+        PositionIndex& index = *m_index;
+        std::size_t nextCheckpoint = index.m_firstPosition + index.size() * index.m_stride;
+        std::size_t position = firstPosition;
+        try {
+            for (Node* node = first; node != nullptr; node = node->getPointerToNext()) {
+                if (position == nextCheckpoint) {
+                    index.m_checkpoints.push_back(node);
+                    nextCheckpoint += index.m_stride;
+                }
+                position++;
+            }
+        }
+        catch (const std::bad_alloc&) {
+            index.m_valid = false;
+        }
+    }
+
+    /**
+     * @description: drops the checkpoints of nodes just unlinked from the front
+     * @param: count - number of nodes that were unlinked
+     */
+    void indexUnlinked(std::size_t count) {
+        if (m_index == nullptr || !m_index->m_valid) {
+            return;
+        }
+        PositionIndex& index = *m_index;
+        // The positions are unsigned, so the checkpoints of the unlinked nodes are dropped before shifting the rest
+        while (index.m_firstPosition < count && index.size() != EMPTY) {
+            index.popFront();
+            index.m_firstPosition += index.m_stride;
+        }
+        index.m_firstPosition = index.m_firstPosition < count ? 0 : index.m_firstPosition - count;
+        if (m_size == EMPTY) {
+            index.m_firstPosition = 0;
+        }
+    }
+
+    /**
+     * @description: builds the index again from the head, after the positions of the nodes changed
+     */
+    void rebuildIndex() {
+        if (m_index == nullptr) {
+            return;
+        }
+        m_index->clear();
+        m_index->m_firstPosition = 0;
+        m_index->m_valid = true;
+        indexLinked(m_head, 0);
+    }
+
+    /**
+     * @param: position of a node, between 0 and the size of the queue
+     * @return: the node at the position, nullptr for the size of the queue
+     * @note: with a valid index the walk starts from the last checkpoint before the position, so it takes fewer
+     *        steps than the stride, otherwise it starts from the head
+     */
+    Node* nodeAt(std::size_t position) const {
+        if (position > m_size) {
+            throw InvalidPosition();
+        }
+        Node* node = m_head;
+        std::size_t steps = position;
+        if (m_index != nullptr && m_index->m_valid && m_index->size() != EMPTY &&
+            position >= m_index->m_firstPosition) {
+            std::size_t checkpoint = (position - m_index->m_firstPosition) / m_index->m_stride;
+            std::size_t checkpointsCount = m_index->size();
+            if (checkpoint >= checkpointsCount) {
+                checkpoint = checkpointsCount - 1;
+            }
+            node = m_index->checkpoint(checkpoint);
+            steps = position - (m_index->m_firstPosition + checkpoint * m_index->m_stride);
+        }
+        for (; steps > 0; --steps) {
+            node = node->getPointerToNext();
+        }
+        return node;
+    }
+
+    /**
+     * @description: deletes a null terminated chain of nodes
+     * @param: first node of the chain
+     */
+    void deleteChain(Node* first) {
+        while (first != nullptr) {
+            Node* next = first->getPointerToNext();
+            destroyNode(first);
+            first = next;
+        }
+    }
+
+    /**
+     * @description: unlinks the first nodes of the queue in one step and deletes them
+     * @param: last - the last node to remove
+     * @param: count - number of nodes from the head to last
+     */
+    void unlinkFront(Node* last, std::size_t count) {
+        Node* first = m_head;
+        m_head = last->getPointerToNext();
+        last->setPointerToNext(nullptr);
+        m_size -= count;
+        if (m_size == EMPTY) {
+            m_tail = nullptr;
+        }
+        indexUnlinked(count);
+        deleteChain(first);
+    }
+
+    /**
+     * @description: unlinks the first node of the queue without deleting it, the index is not updated
+     * @return: the node, its next pointer is nullptr
+     */
+    Node* takeFront() {
+        Node* node = m_head;
+        m_head = node->getPointerToNext();
+        node->setPointerToNext(nullptr);
+        m_size--;
+        if (m_size == EMPTY) {
+            m_tail = nullptr;
+        }
+        return node;
+    }
+
+    /**
+     * @description: copies a range of items into a new null terminated chain of nodes, in a single pass
+     * @param: first, last - range of items to copy
+     * @param: chainHead, chainTail - set to the first and last nodes of the chain, nullptr if the range is empty
+     * @note: if a copy or an allocation throws, the nodes copied so far are deleted and the exception is rethrown
+     * @return: number of nodes in the chain
+     */
+    template<class InputIterator>
+    std::size_t copyChain(InputIterator first, InputIterator last, Node*& chainHead, Node*& chainTail) {
+        Node* head = nullptr;
+        Node* tail = nullptr;
+        std::size_t count = 0;
+        try {
+            for (; first != last; ++first) {
+                Node* node = createNode(*first);
+                if (head == nullptr) {
+                    head = node;
+                }
+                else {
+                    tail->setPointerToNext(node);
+                }
+                tail = node;
+                count++;
+            }
+        }
+        catch (...) {
+            deleteChain(head);
+            throw;
+        }
+        chainHead = head;
+        chainTail = tail;
+        return count;
+    }
 
 public:
     /** Exceptions*/
     class EmptyQueue {};
+    class InvalidPosition {};
 
     /** Constructor for Queue */
-    Queue() : m_head(nullptr), m_size(EMPTY) {}
+    Queue() : m_head(nullptr), m_tail(nullptr), m_size(EMPTY), m_allocator(), m_index() {}
+
+    /** Constructor for Queue with a given allocator
+     * @param: allocator to allocate the nodes with
+     */
+    explicit Queue(const Alloc& allocator) : m_head(nullptr), m_tail(nullptr), m_size(EMPTY), m_allocator(allocator),
+            m_index() {}
+
+    /** Constructor for Queue from a list of items
+     * @param: items to insert, in order
+     * @param: allocator to allocate the nodes with
+     */
+    Queue(std::initializer_list<T> items, const Alloc& allocator = Alloc()) :
+            m_head(nullptr), m_tail(nullptr), m_size(EMPTY), m_allocator(allocator), m_index() {
+        m_size = copyChain(items.begin(), items.end(), m_head, m_tail);
+    }
 
     /** Copy constructor for Queue
      * @param: other queue to copy
      *
+     * @note: the nodes are copied in a single pass, if a copy throws the nodes copied so far are deleted
+     *
      * @return: A new queue with the same items as the "other" queue, independent of the "other" queue
      */
-    Queue(const Queue& other) : m_head(nullptr), m_size(EMPTY) {
-        try{
-            for (Queue<T>::ConstIterator it = other.begin(); it != other.end(); ++it) {
-                // Since pushback creates a new node from the item, even though we use a constIterator, the created Queue should not be const.
-                pushBack(*it);
+    Queue(const Queue& other) : m_head(nullptr), m_tail(nullptr), m_size(EMPTY),
+            m_allocator(NodeTraits::select_on_container_copy_construction(other.m_allocator)), m_index() {
+        m_size = copyChain(other.begin(), other.end(), m_head, m_tail);
+        if (other.m_index != nullptr) {
+            try {
+                enableIndex(other.m_index->m_stride);
             }
-        }
-        catch(std::bad_alloc& e){
-            while(m_size > 0){
-                popFront();
+            catch (...) {
+                deleteChain(m_head);
+                throw;
             }
-            throw e;
         }
     }
 
@@ -121,60 +398,131 @@ public:
      *
      * @note: In case of self assignment, do nothing
      * @constraints: In case of alloc fail ,need to throw std::bad_alloc and leave the original queue unchanged
-     * @constraints: The nodes that are created when initializing the temporary queue should not be deleted, but should
-     * be inserted to the new queue we are creating
+     * @constraints: The nodes that are created when copying the "other" queue should not be deleted, but should
+     * be the nodes of the new queue
      *
-     * @explain: We try to add all "other" queue's items to the end of the original queue with pushBack().
-     *           If all allocations succeed, we remove the original queue's data with popFront().
-     *           If an allocation fails, we remove the additional nodes we successfully allocated with popFront()
-     *           and leave the original queue's data untouched.
+     * @explain: We copy all "other" queue's items into a new chain of nodes in a single pass, on the side.
+     *           If all allocations succeed, we delete the original chain and link the new one in its place.
+     *           If an allocation fails, copyChain deletes the nodes it allocated and the original queue's data is
+     *           untouched.
      *
      * @return: Reference to a new queue with the same items as the "other" queue, independent of the "other" queue
      */
-    Queue<T>& operator=(const Queue& other) {
+    Queue& operator=(const Queue& other) {
+        if(this == &other) {
+            return *this;
+        }
+        Node* chainHead = nullptr;
+        Node* chainTail = nullptr;
+        std::size_t count = copyChain(other.begin(), other.end(), chainHead, chainTail);
+        deleteChain(m_head);
+        m_head = chainHead;
+        m_tail = chainTail;
+        m_size = count;
+        rebuildIndex();
+        return *this;
+    }
+
+    /** assignFrom function, an assignment that reuses the nodes of the queue
+     * @param: other queue to copy
+     *
+     * @explain: The items of "other" are copy assigned into the items already in the queue, so only the difference
+     *           in size is allocated or freed. The nodes missing at the end are copied on the side first, and are
+     *           only linked once all the items were assigned.
+     * @note: if an allocation fails the queue is unchanged. If the copy assignment of an item throws, the items
+     *        before it were already assigned, so the guarantee is strong only if the copy assignment of T is noexcept
+     *
+     * @return: Reference to the queue, holding the same items as the "other" queue
+     */
+    Queue& assignFrom(const Queue& other) {
         if(this == &other) {
             return *this;
         }
-        int successfulAllocCount = 0;
-        int originalSize = m_size;
-        Node* originalHead = (originalSize == 0) ? nullptr : m_head;
+        std::size_t sharedCount = m_size < other.m_size ? m_size : other.m_size;
+        ConstIterator source = other.begin();
+        for (std::size_t i = 0; i < sharedCount; ++i) {
+            ++source;
+        }
+        Node* extraHead = nullptr;
+        Node* extraTail = nullptr;
+        std::size_t extraCount = copyChain(source, other.end(), extraHead, extraTail);
+
+        source = other.begin();
+        Node* current = m_head;
+        Node* lastAssigned = nullptr;
         try {
-            // Try allocating all the nodes (and items) of the "other" queue to the end of the original queue
-            for(Queue<T>::ConstIterator it = other.begin(); it != other.end(); ++it) {
-                pushBack(*it);
-                successfulAllocCount++;
-            }
-            // Remove the original queue's data if all new node (and item) allocations succeeded
-            for(int i = 0; i < originalSize; ++i) {
-                popFront();
+            for (std::size_t i = 0; i < sharedCount; ++i) {
+                current->getReferenceToItem() = *source;
+                lastAssigned = current;
+                current = current->getPointerToNext();
+                ++source;
             }
         }
-        catch (const std::bad_alloc& e) {
-            if(originalSize != 0) { //  If the original queue had data then we need to leave that data untouched
-                // Find the pointer to the node where the nodes we successfully allocated start
-                Node* lastOfOriginalNodes = m_head;
-                for (int i = 0; i < originalSize - 1; ++i) {
-                    lastOfOriginalNodes = lastOfOriginalNodes->getPointerToNext();
-                }
-                // Save the pointer to the first of the additional nodes we successfully allocated:
-                Node* startOfAddedNodes = lastOfOriginalNodes->getPointerToNext();
-                // Set the m_next in the last node of the original queue to "nullptr",
-                // to mark the end of the original queue:
-                lastOfOriginalNodes->setPointerToNext(nullptr);
-                // Temporarily set the m_head to the first node of the additional nodes
-                // in order to later remove them by using popFront():
-                m_head = startOfAddedNodes;
+        catch (...) {
+            deleteChain(extraHead);
+            throw;
+        }
+
+        if (extraCount != EMPTY) {
+            linkBack(extraHead, extraTail, extraCount);
+        }
+        else if (current != nullptr) {
+            // "other" is shorter, the nodes after the last assigned one are freed
+            deleteChain(current);
+            if (lastAssigned == nullptr) {
+                m_head = nullptr;
             }
-            for(int i = 0; i < successfulAllocCount; ++i) { // Remove the additional nodes we successfully allocated
-                popFront();
+            else {
+                lastAssigned->setPointerToNext(nullptr);
             }
-            // Restore the original queue to its untouched state
-            m_head = originalHead;
-            throw e;
+            m_tail = lastAssigned;
+            m_size = sharedCount;
+            rebuildIndex();
         }
         return *this;
     }
 
+    /** Move constructor for Queue
+     * @param: other queue to move from
+     *
+     * @note: the nodes of "other" are taken over in O(1), "other" is left empty
+     */
+    Queue(Queue&& other) noexcept : m_head(other.m_head), m_tail(other.m_tail), m_size(other.m_size),
+            m_allocator(std::move(other.m_allocator)), m_index(std::move(other.m_index)) {
+        other.m_head = nullptr;
+        other.m_tail = nullptr;
+        other.m_size = EMPTY;
+    }
+
+    /** Move assignment operator for Queue
+     * @param: other queue to move from
+     *
+     * @note: the original items are destroyed, "other" is left empty
+     * @note: the allocator of "other" is taken over along with its nodes
+     *
+     * @return: Reference to the queue, holding the nodes of "other"
+     */
+    Queue& operator=(Queue&& other) noexcept {
+        if(this != &other) {
+            Queue temporary(std::move(other));
+            swap(temporary);
+        }
+        return *this;
+    }
+
+    /** swap function
+     * @param: other queue to exchange contents with, in O(1)
+     * @note: the allocators are exchanged along with the nodes
+     */
+    void swap(Queue& other) noexcept {
+        using std::swap;
+        swap(m_allocator, other.m_allocator);
+        std::swap(m_head, other.m_head);
+        std::swap(m_tail, other.m_tail);
+        std::swap(m_size, other.m_size);
+        m_index.swap(other.m_index);
+    }
+
     /** Destructor for Queue*/
     ~Queue() {
         while(m_size > 0) {
@@ -231,17 +579,20 @@ public:
             return m_pointer != other.m_pointer;
         }
 
-        ConstIterator& operator+(int valueToIncrement) const{ // Is not needed for this exercise
-            Node *current = this->m_pointer;
+        /**
+         * @param: valueToIncrement - number of items to skip, the result may be the end
+         * @note: walks node by node, Queue::iteratorAt uses the index of an indexed queue instead
+         * @return: a new iterator, this one is unchanged
+         */
+        ConstIterator operator+(int valueToIncrement) const {
             if (valueToIncrement < 0) {
                 throw InvalidOperation();
             }
-            while (current->getPointerToNext() != nullptr && valueToIncrement > 0) {
-                this->m_pointer = current;
-                current = current->getPointerToNext();
-                valueToIncrement -= 1;
+            ConstIterator result(*this);
+            for (; valueToIncrement > 0; --valueToIncrement) {
+                ++result;
             }
-            return *this;
+            return result;
         }
     };
 
@@ -296,17 +647,20 @@ public:
             return m_pointer != other.m_pointer;
         }
 
-        Iterator& operator+(int valueToIncrement) { // Is not needed for this exercise
-            Node *current = this->m_pointer;
+        /**
+         * @param: valueToIncrement - number of items to skip, the result may be the end
+         * @note: walks node by node, Queue::iteratorAt uses the index of an indexed queue instead
+         * @return: a new iterator, this one is unchanged
+         */
+        Iterator operator+(int valueToIncrement) const {
             if (valueToIncrement < 0) {
                 throw InvalidOperation();
             }
-            while (current->getPointerToNext() != nullptr && valueToIncrement > 0) {
-                this->m_pointer = current;
-                current = current->getPointerToNext();
-                valueToIncrement -= 1;
+            Iterator result(*this);
+            for (; valueToIncrement > 0; --valueToIncrement) {
+                ++result;
             }
-            return *this;
+            return result;
         }
     };
 
@@ -332,49 +686,119 @@ public:
         return ConstIterator(nullptr);
     }
 
-    // Used in pushBack function
-    Node* findLastNode(Queue<T>& queue) {
-        if (queue.m_size == EMPTY) {
-            return m_head;
-        }
-        Node* last = queue.m_head;
-        while (last->Node::getPointerToNext() != nullptr) {
-            last = last->Node::getPointerToNext();
-        }
-        return last;
+    /** pushBack function
+     * @param: item to insert to the
+     *
+     * @return reference to the queue, so we can concatenate functions
+     *
+     * @note: the item is copied, not inserted itself into the queue
+     * @note: the queue keeps a pointer to its last node, so this is O(1)
+     */
+    Queue& pushBack(const T& toInsert) {
+        Node* nodeToPush = createNode(toInsert);
+        linkBack(nodeToPush, nodeToPush, 1);
+        return *this;
     }
 
-    // Used in pushBack function
-    void insertAfter(Node *firstNode, Node *secondNode) {
-        firstNode->Node::setPointerToNext(secondNode);
+    /** pushBack function for temporaries
+     * @param: item to move into the queue
+     *
+     * @return reference to the queue, so we can concatenate functions
+     */
+    Queue& pushBack(T&& toInsert) {
+        Node* nodeToPush = createNode(std::move(toInsert));
+        linkBack(nodeToPush, nodeToPush, 1);
+        return *this;
     }
 
-    /** pushBack function
-     * @param: item to insert to the
+    /** emplaceBack function
+     * @param: arguments forwarded to the constructor of the new item, which is built inside its node
      *
      * @return reference to the queue, so we can concatenate functions
+     */
+    template<class... Args>
+    Queue& emplaceBack(Args&&... args) {
+        Node* nodeToPush = createNode(std::forward<Args>(args)...);
+        linkBack(nodeToPush, nodeToPush, 1);
+        return *this;
+    }
+
+    /** splice function
+     * @param: other queue, whose nodes are moved to the end of this queue
      *
-     * @note: the item is copied, not inserted itself into the queue
+     * @note: no item is copied or allocated, the nodes of "other" are relinked in O(1) and "other" is left empty
+     * @note: if the allocators of the queues differ, the items are moved one by one into new nodes instead
+     *
+     * @return reference to the queue, so we can concatenate functions
      */
-    Queue<T>& pushBack(const T& toInsert) {
-        Node* nodeToPush;
-        try{
-            nodeToPush = new Node(toInsert);
-        }
-        catch(std::bad_alloc& e){
-            throw e;
+    Queue& splice(Queue&& other) {
+        if (this == &other || other.m_size == EMPTY) {
+            return *this;
         }
-        if (this->m_size == EMPTY) {
-            m_head = nodeToPush;
+        if (!(m_allocator == other.m_allocator)) {
+            Queue moved(get_allocator());
+            for (Iterator it = other.begin(); it != other.end(); ++it) {
+                moved.emplaceBack(std::move(*it));
+            }
+            other.deleteChain(other.m_head);
+            other.m_head = nullptr;
+            other.m_tail = nullptr;
+            other.m_size = EMPTY;
+            other.rebuildIndex();
+            return splice(std::move(moved));
         }
-        else {
-            Node* lastElement = findLastNode(*this);
-            insertAfter(lastElement, nodeToPush);
+        linkBack(other.m_head, other.m_tail, other.m_size);
+        other.m_head = nullptr;
+        other.m_tail = nullptr;
+        other.m_size = EMPTY;
+        other.rebuildIndex();
+        return *this;
+    }
+
+    /** appendRange function
+     * @param: first, last - range of items to insert to the end of the queue
+     *
+     * @constraints: In case of alloc fail, need to throw std::bad_alloc and leave the queue unchanged
+     * @explain: The new nodes are chained in a single pass on the side and linked after the tail only once
+     *           all of them were allocated successfully.
+     *
+     * @return reference to the queue, so we can concatenate functions
+     */
+    template<class InputIterator>
+    Queue& appendRange(InputIterator first, InputIterator last) {
+        Node* chainHead = nullptr;
+        Node* chainTail = nullptr;
+        std::size_t count = copyChain(first, last, chainHead, chainTail);
+        if (count != EMPTY) {
+            linkBack(chainHead, chainTail, count);
         }
-        m_size += 1;
         return *this;
     }
 
+    /** pushBack function for a range of items, the whole batch is inserted or none of it
+     * @param: first, last - range of items to insert to the end of the queue, in order
+     *
+     * @note: the same as appendRange, the new chain is built on the side and linked after the tail with a single
+     *        pointer write, so if an allocation fails the queue is unchanged
+     * @note: only takes part in overload resolution for iterators, so pushBack(1, 2) on a Queue<int> does not compile
+     *
+     * @return reference to the queue, so we can concatenate functions
+     */
+    template<class InputIterator,
+             class = typename std::enable_if<!std::is_integral<InputIterator>::value>::type>
+    Queue& pushBack(InputIterator first, InputIterator last) {
+        return appendRange(first, last);
+    }
+
+    /** pushBack function for a list of items, the whole list is inserted or none of it
+     * @param: items to insert to the end of the queue, in order
+     *
+     * @return reference to the queue, so we can concatenate functions
+     */
+    Queue& pushBack(std::initializer_list<T> items) {
+        return appendRange(items.begin(), items.end());
+    }
+
     /** front function
      * @param: queue
      *
@@ -409,8 +833,245 @@ public:
             throw EmptyQueue();
         }
         m_head = m_head->Node::getPointerToNext();
-        delete firstElement;
+        destroyNode(firstElement);
         m_size--;
+        if (m_size == EMPTY) {
+            m_tail = nullptr;
+        }
+        indexUnlinked(1);
+    }
+
+    /**
+     * @param: destination the first element is moved into
+     *
+     * @description: moves the first element of the queue out and removes it
+     * @note: if the move throws, the queue is left unchanged
+     *
+     * @return none
+     */
+    void popFront(T& destination) {
+        if (m_size == EMPTY) {
+            throw EmptyQueue();
+        }
+        destination = std::move(m_head->getReferenceToItem());
+        popFront();
+    }
+
+    /**
+     * @param: maxCount - the most items to remove from the front of the queue
+     *
+     * @description: removes up to maxCount items from the front, unlinking them from the queue in one step
+     * @note: an empty queue is not an error, nothing is removed
+     *
+     * @return number of removed items
+     */
+    std::size_t popFrontBatch(std::size_t maxCount) {
+        std::size_t count = m_size < maxCount ? m_size : maxCount;
+        if (count == EMPTY) {
+            return EMPTY;
+        }
+        Node* last = m_head;
+        for (std::size_t i = 1; i < count; ++i) {
+            last = last->getPointerToNext();
+        }
+        unlinkFront(last, count);
+        return count;
+    }
+
+    /**
+     * @param: destination - output iterator the items are moved into, in their order
+     * @param: maxCount - the most items to move out
+     *
+     * @description: moves up to maxCount items out of the front of the queue, then unlinks their nodes in one step
+     * @note: an empty queue is not an error, nothing is moved
+     * @note: if moving an item throws, the items moved before it are removed and the exception is rethrown
+     *
+     * @return number of items moved out and removed
+     */
+    template<class OutputIterator>
+    std::size_t drainTo(OutputIterator destination, std::size_t maxCount) {
+        std::size_t count = m_size < maxCount ? m_size : maxCount;
+        if (count == EMPTY) {
+            return EMPTY;
+        }
+        Node* last = nullptr;
+        Node* current = m_head;
+        std::size_t moved = 0;
+        try {
+            for (; moved < count; ++moved) {
+                *destination = std::move(current->getReferenceToItem());
+                ++destination;
+                last = current;
+                current = current->getPointerToNext();
+            }
+        }
+        catch (...) {
+            if (moved != EMPTY) {
+                unlinkFront(last, moved);
+            }
+            throw;
+        }
+        unlinkFront(last, count);
+        return count;
+    }
+
+    /** removeIf function
+     * @param: predicate - the items it returns true for are removed
+     *
+     * @explain: A single pass over the nodes unlinks the rejected nodes and destroys them, the other nodes stay
+     *           where they are, so no item is copied or allocated and the order is kept.
+     * @note: if the predicate throws, the items it already rejected are removed and the rest of the queue is intact
+     *
+     * @return number of removed items
+     */
+    template<class PRED>
+    std::size_t removeIf(PRED predicate) {
+        std::size_t removedCount = 0;
+        Node* previous = nullptr;
+        Node* current = m_head;
+        try {
+            while (current != nullptr) {
+                Node* next = current->getPointerToNext();
+                if (predicate(current->getReferenceToItem()) == true) {
+                    if (previous == nullptr) {
+                        m_head = next;
+                    }
+                    else {
+                        previous->setPointerToNext(next);
+                    }
+                    if (current == m_tail) {
+                        m_tail = previous;
+                    }
+                    destroyNode(current);
+                    m_size--;
+                    removedCount++;
+                }
+                else {
+                    previous = current;
+                }
+                current = next;
+            }
+        }
+        catch (...) {
+            rebuildIndex();
+            throw;
+        }
+        if (removedCount != EMPTY) {
+            rebuildIndex();
+        }
+        return removedCount;
+    }
+
+    /** partition function
+     * @param: predicate - sorts the items between the two queues
+     *
+     * @explain: The nodes are unlinked from the front one by one and linked to the back of one of two queues, so no
+     *           item is copied or allocated, the relative order is kept and this queue is left empty. The answers of
+     *           the predicate are kept on the side, one bit per item, in room reserved before any node moves.
+     * @note: if the predicate throws, the answers tell which queue every tested node went to, so the nodes are
+     *        linked back in their original order in front of the untested ones, and the exception is rethrown
+     * @throw: std::bad_alloc if the room for the answers could not be allocated, the queue is unchanged
+     *
+     * @return the queue of the items the predicate returned true for, and the queue of the other items
+     */
+    template<class PRED>
+    std::pair<Queue, Queue> partition(PRED predicate) {
+        std::vector<bool> passed;
+        passed.reserve(m_size);
+        Queue accepted(get_allocator());
+        Queue rejected(get_allocator());
+        try {
+            while (m_head != nullptr) {
+                passed.push_back(predicate(m_head->getReferenceToItem()) == true);
+                Node* node = takeFront();
+                (passed.back() ? accepted : rejected).linkBack(node, node, 1);
+            }
+        }
+        catch (...) {
+            Queue restored(get_allocator());
+            for (std::vector<bool>::const_iterator answer = passed.begin(); answer != passed.end(); ++answer) {
+                Node* node = (*answer ? accepted : rejected).takeFront();
+                restored.linkBack(node, node, 1);
+            }
+            restored.splice(std::move(*this));
+            splice(std::move(restored));
+            rebuildIndex();
+            throw;
+        }
+        rebuildIndex();
+        return std::make_pair(std::move(accepted), std::move(rejected));
+    }
+
+    /** enableIndex function, turns on the indexed mode
+     * @param: stride - distance between the nodes the index points to, it takes size / stride pointers of memory
+     *
+     * @explain: The index keeps a pointer to every stride-th node in a vector. pushBack and popFront keep it up
+     *           to date in O(1), the operations that move nodes around build it again in O(n). at, iteratorAt and
+     *           the parallel filter and transform then reach any position in fewer steps than the stride.
+     * @throw: std::bad_alloc if the index could not be built, the queue stays unindexed
+     */
+    void enableIndex(std::size_t stride = DEFAULT_INDEX_STRIDE) {
+        if (stride == 0) {
+            stride = DEFAULT_INDEX_STRIDE;
+        }
+        std::unique_ptr<PositionIndex> index(new PositionIndex(stride));
+        std::swap(m_index, index);
+        rebuildIndex();
+        if (!m_index->m_valid) {
+            m_index.reset();
+            throw std::bad_alloc();
+        }
+    }
+
+    /** disableIndex function, turns off the indexed mode and frees the index */
+    void disableIndex() {
+        m_index.reset();
+    }
+
+    /**
+     * @return true if the queue keeps an index of its positions
+     */
+    bool isIndexed() const {
+        return m_index != nullptr;
+    }
+
+    /**
+     * @param: position of an item, 0 for the first one
+     * @throw: InvalidPosition if there is no item at the position
+     * @return reference to the item at the position
+     */
+    T& at(std::size_t position) {
+        if (position >= m_size) {
+            throw InvalidPosition();
+        }
+        return nodeAt(position)->getReferenceToItem();
+    }
+
+    const T& at(std::size_t position) const {
+        if (position >= m_size) {
+            throw InvalidPosition();
+        }
+        return nodeAt(position)->getReferenceToItem();
+    }
+
+    /**
+     * @param: position of an item, the size of the queue for end()
+     * @throw: InvalidPosition if the position is outside the queue
+     * @return iterator to the item at the position
+     */
+    Iterator iteratorAt(std::size_t position) {
+        return Iterator(nodeAt(position));
+    }
+
+    ConstIterator iteratorAt(std::size_t position) const {
+        return ConstIterator(nodeAt(position));
+    }
+
+    /**
+     * @return copy of the allocator of the queue
+     */
+    Alloc get_allocator() const {
+        return Alloc(m_allocator);
     }
 
     /**
@@ -418,15 +1079,15 @@ public:
      *
      * @return number of elements in the queue
      */
-    int size() const{
+    std::size_t size() const{
         return m_size;
     }
 };
 
-template<typename T, typename FUNC>
-Queue<T> filter(const Queue<T>& queueToFilter, FUNC filterFunction) {
-    Queue<T> newFilteredQueue;
-    for (typename Queue<T>::ConstIterator i = queueToFilter.begin(); i != queueToFilter.end(); ++i){
+template<typename T, class Alloc, typename FUNC>
+Queue<T, Alloc> filter(const Queue<T, Alloc>& queueToFilter, FUNC filterFunction) {
+    Queue<T, Alloc> newFilteredQueue(queueToFilter.get_allocator());
+    for (typename Queue<T, Alloc>::ConstIterator i = queueToFilter.begin(); i != queueToFilter.end(); ++i){
         if(filterFunction(*i) == true){
             try {
                 newFilteredQueue.pushBack(*i);
@@ -439,9 +1100,14 @@ Queue<T> filter(const Queue<T>& queueToFilter, FUNC filterFunction) {
     return newFilteredQueue;
 }
 
-template<typename T, typename FUNC>
-void transform(Queue<T>& queueToTransform, FUNC transformFunction) {
-    for (typename Queue<T>::Iterator i = queueToTransform.begin(); i != queueToTransform.end(); ++i) {
+template<class T, class Alloc>
+void swap(Queue<T, Alloc>& first, Queue<T, Alloc>& second) noexcept {
+    first.swap(second);
+}
+
+template<typename T, class Alloc, typename FUNC>
+void transform(Queue<T, Alloc>& queueToTransform, FUNC transformFunction) {
+    for (typename Queue<T, Alloc>::Iterator i = queueToTransform.begin(); i != queueToTransform.end(); ++i) {
         T& itemReference = *i;
         transformFunction(itemReference);
     }
@@ -0,0 +1,1123 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include "relativeIncludes.h"
+
+// Once the replacements below are inlined, GCC mistakes their malloc/free pairs for mismatched new/free
+#pragma GCC diagnostic ignored "-Wpragmas"
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+/**
+ * Every global allocation is counted, so the benchmarks can report allocations and bytes per operation. The
+ * threaded benchmarks allocate from several threads, so the counters are atomic, and relaxed since they are only
+ * read after the threads joined.
+ */
+static std::atomic<long long> allocationCount(0);
+static std::atomic<long long> allocatedBytes(0);
+
+void* operator new(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+    void* memory = std::malloc(size == 0 ? 1 : size);
+    if (memory == nullptr){
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+class Measurement{
+public:
+    Measurement() :
+        m_start(std::chrono::steady_clock::now()),
+        m_startAllocations(allocationCount.load(std::memory_order_relaxed)) {}
+
+    /**
+     * @description: prints the time and the allocations per operation since the measurement started
+     * @param: name of the benchmark
+     * @param: operations done since the measurement started
+     */
+    void report(const std::string& name, long long operations) const
+    {
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - m_start;
+        long long allocations = allocationCount.load(std::memory_order_relaxed) - m_startAllocations;
+        std::cout << std::left << std::setw(56) << name
+                  << std::right << std::setw(12) << std::fixed << std::setprecision(2)
+                  << elapsed.count() / operations << " ns/op"
+                  << std::setw(12) << static_cast<double>(allocations) / operations << " allocs/op" << std::endl;
+    }
+
+private:
+    std::chrono::steady_clock::time_point m_start;
+    long long m_startAllocations;
+};
+
+/** Keeps the optimizer from throwing away the results of a benchmark */
+static volatile long long sink = 0;
+
+static const int CHURN_QUEUE_SIZE = 1024;
+static const int CHURN_OPERATIONS = 4000000;
+
+template <class QUEUE>
+static void benchmarkChurn(const std::string& name)
+{
+    QUEUE q;
+    for (int i = 0; i < CHURN_QUEUE_SIZE; ++i){
+        q.pushBack(i);
+    }
+    Measurement measurement;
+    long long sum = 0;
+    for (int i = 0; i < CHURN_OPERATIONS; ++i){
+        sum += q.front();
+        q.popFront();
+        q.pushBack(i);
+    }
+    measurement.report(name, CHURN_OPERATIONS);
+    sink = sum;
+}
+
+/** An item that embeds its own link, the caller owns it and the queue only relinks it */
+struct ChurnItem{
+    int m_value;
+    IntrusiveHook<ChurnItem> m_hook;
+
+    ChurnItem() : m_value(0), m_hook() {}
+};
+
+static void benchmarkIntrusiveChurn(const std::string& name)
+{
+    std::vector<ChurnItem> items(CHURN_QUEUE_SIZE);
+    IntrusiveQueue<ChurnItem, &ChurnItem::m_hook> q;
+    for (int i = 0; i < CHURN_QUEUE_SIZE; ++i){
+        items[i].m_value = i;
+        q.pushBack(items[i]);
+    }
+    Measurement measurement;
+    long long sum = 0;
+    for (int i = 0; i < CHURN_OPERATIONS; ++i){
+        ChurnItem& item = q.front();
+        sum += item.m_value;
+        q.popFront();
+        item.m_value = i;
+        q.pushBack(item);
+    }
+    measurement.report(name, CHURN_OPERATIONS);
+    sink = sum;
+}
+
+static const int SCAN_QUEUE_SIZE = 1000000;
+static const int SCAN_REPEATS = 20;
+
+static bool isOdd(int n)
+{
+    return n % 2 != 0;
+}
+
+static void addOne(int& n)
+{
+    ++n;
+}
+
+template <class QUEUE>
+static void benchmarkScan(const std::string& name)
+{
+    QUEUE q;
+    for (int i = 0; i < SCAN_QUEUE_SIZE; ++i){
+        q.pushBack(i);
+    }
+    Measurement measurement;
+    long long sum = 0;
+    for (int repeat = 0; repeat < SCAN_REPEATS; ++repeat){
+        transform(q, addOne);
+        sum += filter(q, isOdd).size();
+    }
+    measurement.report(name, static_cast<long long>(SCAN_QUEUE_SIZE) * SCAN_REPEATS);
+    sink = sum;
+}
+
+/** The single threaded Queue behind a mutex, the baseline for the concurrent queues */
+template <class T>
+class LockedQueue{
+public:
+    bool tryPushBack(const T& item)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.pushBack(item);
+        return true;
+    }
+
+    bool tryPopFront(T& destination)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_queue.size() == 0){
+            return false;
+        }
+        m_queue.popFront(destination);
+        return true;
+    }
+
+    bool tryPush(const T& item)
+    {
+        return tryPushBack(item);
+    }
+
+    bool tryPop(T& destination)
+    {
+        return tryPopFront(destination);
+    }
+
+private:
+    std::mutex m_mutex;
+    Queue<T> m_queue;
+};
+
+template <class CHANNEL>
+static void pushWhenPossible(CHANNEL& channel, int item)
+{
+    while (!channel.tryPushBack(item)){
+        std::this_thread::yield();
+    }
+}
+
+template <class CHANNEL>
+static int popWhenPossible(CHANNEL& channel)
+{
+    int item = 0;
+    while (!channel.tryPopFront(item)){
+        std::this_thread::yield();
+    }
+    return item;
+}
+
+static const int HANDOFF_ITEMS = 2000000;
+static const int ROUND_TRIPS = 100000;
+
+/**
+ * @description: one thread pushes items that another thread pops, reports the time per item
+ */
+template <class CHANNEL>
+static void benchmarkHandoff(const std::string& name, CHANNEL& channel)
+{
+    Measurement measurement;
+    std::thread producer([&channel]()
+    {
+        for (int i = 0; i < HANDOFF_ITEMS; ++i){
+            pushWhenPossible(channel, i);
+        }
+    });
+    long long sum = 0;
+    for (int i = 0; i < HANDOFF_ITEMS; ++i){
+        sum += popWhenPossible(channel);
+    }
+    producer.join();
+    measurement.report(name, HANDOFF_ITEMS);
+    sink = sum;
+}
+
+/**
+ * @description: two threads bounce an item over a pair of queues, reports the time per one way trip
+ */
+template <class CHANNEL>
+static void benchmarkPingPong(const std::string& name, CHANNEL& ping, CHANNEL& pong)
+{
+    Measurement measurement;
+    std::thread responder([&ping, &pong]()
+    {
+        for (int i = 0; i < ROUND_TRIPS; ++i){
+            pushWhenPossible(pong, popWhenPossible(ping) + 1);
+        }
+    });
+    long long sum = 0;
+    for (int i = 0; i < ROUND_TRIPS; ++i){
+        pushWhenPossible(ping, i);
+        sum += popWhenPossible(pong);
+    }
+    responder.join();
+    measurement.report(name, 2LL * ROUND_TRIPS);
+    sink = sum;
+}
+
+static const int SPSC_CAPACITY = 1024;
+
+static void handoffLockedQueue()
+{
+    LockedQueue<int> channel;
+    benchmarkHandoff("two thread handoff, mutex + Queue", channel);
+}
+
+static void handoffSpscQueue()
+{
+    SpscQueue<int> channel(SPSC_CAPACITY);
+    benchmarkHandoff("two thread handoff, SpscQueue", channel);
+}
+
+static void pingPongLockedQueue()
+{
+    LockedQueue<int> ping, pong;
+    benchmarkPingPong("two thread latency, mutex + Queue", ping, pong);
+}
+
+static void pingPongSpscQueue()
+{
+    SpscQueue<int> ping(SPSC_CAPACITY), pong(SPSC_CAPACITY);
+    benchmarkPingPong("two thread latency, SpscQueue", ping, pong);
+}
+
+static const int SHARED_OPERATIONS = 2000000;
+
+/**
+ * @description: every thread pushes an item and pops one, over and over, on one shared queue
+ * @param: threadsCount - number of threads sharing the queue, the operations are split between them
+ */
+template <class SHARED>
+static void benchmarkShared(const std::string& name, int threadsCount)
+{
+    SHARED shared;
+    std::vector<std::thread> threads;
+    std::atomic<long long> total(0);
+    Measurement measurement;
+    for (int t = 0; t < threadsCount; ++t){
+        threads.emplace_back([&shared, &total, threadsCount]()
+        {
+            long long sum = 0;
+            int out = 0;
+            for (int i = 0; i < SHARED_OPERATIONS / threadsCount; ++i){
+                shared.tryPush(i);
+                if (shared.tryPop(out)){
+                    sum += out;
+                }
+            }
+            total.fetch_add(sum);
+        });
+    }
+    for (std::thread& thread : threads){
+        thread.join();
+    }
+    measurement.report(name + ", " + std::to_string(threadsCount) + " threads", SHARED_OPERATIONS);
+    sink = total.load();
+}
+
+/** Thread counts from 1 up to the number of cores, and at least up to 4 */
+static std::vector<int> scalingThreadCounts()
+{
+    int cores = static_cast<int>(std::thread::hardware_concurrency());
+    std::vector<int> counts;
+    for (int count = 1; count <= std::max(cores, 4); count *= 2){
+        counts.push_back(count);
+    }
+    return counts;
+}
+
+static void sharedLockedQueue()
+{
+    for (int threadsCount : scalingThreadCounts()){
+        benchmarkShared<LockedQueue<int>>("shared push+pop, mutex + Queue", threadsCount);
+    }
+}
+
+static void sharedConcurrentQueue()
+{
+    for (int threadsCount : scalingThreadCounts()){
+        benchmarkShared<ConcurrentQueue<int>>("shared push+pop, ConcurrentQueue", threadsCount);
+    }
+}
+
+static const int PARALLEL_ITEMS = 4000000;
+static const int PARALLEL_GRAIN = 4096;
+static const int PARALLEL_REPEATS = 10;
+
+static void heavyUpdate(int& n)
+{
+    for (int i = 0; i < 8; ++i){
+        n = n * 1103515245 + 12345;
+    }
+}
+
+/** Worker threads that run std::function tasks from one Queue behind one mutex, the baseline for ThreadPool */
+class LockedTaskPool{
+public:
+    explicit LockedTaskPool(int workersCount) : m_stopping(false)
+    {
+        for (int i = 0; i < workersCount; ++i){
+            m_workers.emplace_back([this]()
+            {
+                std::function<void()> task;
+                while (true){
+                    {
+                        std::unique_lock<std::mutex> lock(m_mutex);
+                        m_wakeUp.wait(lock, [this]() { return m_tasks.size() > 0 || m_stopping; });
+                        if (m_tasks.size() == 0){
+                            return;
+                        }
+                        m_tasks.popFront(task);
+                    }
+                    task();
+                }
+            });
+        }
+    }
+
+    ~LockedTaskPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_wakeUp.notify_all();
+        for (std::thread& worker : m_workers){
+            worker.join();
+        }
+    }
+
+    void submit(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.pushBack(std::move(task));
+        }
+        m_wakeUp.notify_one();
+    }
+
+private:
+    std::vector<std::thread> m_workers;
+    Queue<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeUp;
+    bool m_stopping;
+};
+
+static void parallelLockedQueue()
+{
+    std::vector<int> items(PARALLEL_ITEMS, 1);
+    for (int threadsCount : scalingThreadCounts()){
+        LockedTaskPool pool(threadsCount);
+        Measurement measurement;
+        for (int repeat = 0; repeat < PARALLEL_REPEATS; ++repeat){
+            std::atomic<int> pending(0);
+            for (int first = 0; first < PARALLEL_ITEMS; first += PARALLEL_GRAIN){
+                pending.fetch_add(1);
+                pool.submit([&items, &pending, first]()
+                {
+                    for (int i = first; i < std::min(first + PARALLEL_GRAIN, PARALLEL_ITEMS); ++i){
+                        heavyUpdate(items[i]);
+                    }
+                    pending.fetch_sub(1);
+                });
+            }
+            while (pending.load() > 0){
+                std::this_thread::yield();
+            }
+        }
+        measurement.report("parallel update, locked Queue<std::function>, " + std::to_string(threadsCount) +
+                           " threads", static_cast<long long>(PARALLEL_ITEMS) * PARALLEL_REPEATS);
+    }
+    sink = items[0];
+}
+
+static void parallelThreadPool()
+{
+    std::vector<int> items(PARALLEL_ITEMS, 1);
+    for (int threadsCount : scalingThreadCounts()){
+        ThreadPool pool(threadsCount);
+        Measurement measurement;
+        for (int repeat = 0; repeat < PARALLEL_REPEATS; ++repeat){
+            pool.parallelFor(0, PARALLEL_ITEMS, PARALLEL_GRAIN, [&items](int first, int last)
+            {
+                for (int i = first; i < last; ++i){
+                    heavyUpdate(items[i]);
+                }
+            });
+        }
+        measurement.report("parallel update, ThreadPool::parallelFor, " + std::to_string(threadsCount) + " threads",
+                           static_cast<long long>(PARALLEL_ITEMS) * PARALLEL_REPEATS);
+    }
+    sink = items[0];
+}
+
+static const int CHUNKED_ITEMS = 1000000;
+static const int CHUNKED_REPEATS = 5;
+static const int CHUNKED_MAX_THREADS = 16;
+
+/** A predicate that costs about as much as a small hash, so the evaluation dominates the copying */
+static bool expensiveIsOdd(int n)
+{
+    heavyUpdate(n);
+    heavyUpdate(n);
+    return (n & 1) == 1;
+}
+
+static void parallelFilter()
+{
+    Queue<int> q;
+    for (int i = 0; i < CHUNKED_ITEMS; ++i){
+        q.pushBack(i);
+    }
+    long long sum = 0;
+    Measurement serial;
+    for (int repeat = 0; repeat < CHUNKED_REPEATS; ++repeat){
+        sum += filter(q, expensiveIsOdd).size();
+    }
+    serial.report("filter, serial", static_cast<long long>(CHUNKED_ITEMS) * CHUNKED_REPEATS);
+    for (int threadsCount = 1; threadsCount <= CHUNKED_MAX_THREADS; threadsCount *= 2){
+        Measurement measurement;
+        for (int repeat = 0; repeat < CHUNKED_REPEATS; ++repeat){
+            sum += filter(q, expensiveIsOdd, threadsCount).size();
+        }
+        measurement.report("filter, " + std::to_string(threadsCount) + " threads",
+                           static_cast<long long>(CHUNKED_ITEMS) * CHUNKED_REPEATS);
+    }
+    sink = sum;
+}
+
+static void parallelTransform()
+{
+    Queue<int> q;
+    for (int i = 0; i < CHUNKED_ITEMS; ++i){
+        q.pushBack(i);
+    }
+    Measurement serial;
+    for (int repeat = 0; repeat < CHUNKED_REPEATS; ++repeat){
+        transform(q, heavyUpdate);
+    }
+    serial.report("transform, serial", static_cast<long long>(CHUNKED_ITEMS) * CHUNKED_REPEATS);
+    for (int threadsCount = 1; threadsCount <= CHUNKED_MAX_THREADS; threadsCount *= 2){
+        Measurement measurement;
+        for (int repeat = 0; repeat < CHUNKED_REPEATS; ++repeat){
+            transform(q, heavyUpdate, threadsCount);
+        }
+        measurement.report("transform, " + std::to_string(threadsCount) + " threads",
+                           static_cast<long long>(CHUNKED_ITEMS) * CHUNKED_REPEATS);
+    }
+    sink = q.front();
+}
+
+static int timesThree(int n)
+{
+    return n * 3;
+}
+
+/** Sums the odd items times three, through intermediate queues */
+static void pipelineMaterialized()
+{
+    Queue<int> q;
+    for (int i = 0; i < SCAN_QUEUE_SIZE; ++i){
+        q.pushBack(i);
+    }
+    Measurement measurement;
+    long long sum = 0;
+    for (int repeat = 0; repeat < SCAN_REPEATS; ++repeat){
+        Queue<int> odds = filter(q, isOdd);
+        transform(odds, [](int& n) { n = timesThree(n); });
+        for (int n : odds){
+            sum += n;
+        }
+    }
+    measurement.report("pipeline sum, filter() + transform()", static_cast<long long>(SCAN_QUEUE_SIZE) * SCAN_REPEATS);
+    sink = sum;
+}
+
+/** Sums the odd items times three, through a lazy view */
+static void pipelineView()
+{
+    Queue<int> q;
+    for (int i = 0; i < SCAN_QUEUE_SIZE; ++i){
+        q.pushBack(i);
+    }
+    Measurement measurement;
+    long long sum = 0;
+    for (int repeat = 0; repeat < SCAN_REPEATS; ++repeat){
+        for (int n : q | filtered(isOdd) | transformed(timesThree)){
+            sum += n;
+        }
+    }
+    measurement.report("pipeline sum, filtered | transformed", static_cast<long long>(SCAN_QUEUE_SIZE) * SCAN_REPEATS);
+    sink = sum;
+}
+
+static const int REMOVE_QUEUE_SIZE = 200000;
+static const int REMOVE_PAYLOAD_SIZE = 16;
+
+static Queue<std::vector<int>> makeVectorsQueue()
+{
+    Queue<std::vector<int>> q;
+    for (int i = 0; i < REMOVE_QUEUE_SIZE; ++i){
+        q.pushBack(std::vector<int>(REMOVE_PAYLOAD_SIZE, i));
+    }
+    return q;
+}
+
+static bool startsEven(const std::vector<int>& items)
+{
+    return items[0] % 2 == 0;
+}
+
+static bool startsOdd(const std::vector<int>& items)
+{
+    return items[0] % 2 != 0;
+}
+
+/** Drops the odd half of a queue of vectors by filtering a copy and assigning it back */
+static void removeByFilter()
+{
+    Queue<std::vector<int>> q = makeVectorsQueue();
+    Measurement measurement;
+    q = filter(q, startsEven);
+    measurement.report("remove half of Queue<vector>, filter() + assign", REMOVE_QUEUE_SIZE);
+    sink = q.size();
+}
+
+/** Drops the odd half of a queue of vectors in place */
+static void removeByRemoveIf()
+{
+    Queue<std::vector<int>> q = makeVectorsQueue();
+    Measurement measurement;
+    q.removeIf(startsOdd);
+    measurement.report("remove half of Queue<vector>, removeIf()", REMOVE_QUEUE_SIZE);
+    sink = q.size();
+}
+
+/** Splits a queue of vectors in two in place */
+static void removeByPartition()
+{
+    Queue<std::vector<int>> q = makeVectorsQueue();
+    Measurement measurement;
+    std::pair<Queue<std::vector<int>>, Queue<std::vector<int>>> parts = q.partition(startsEven);
+    measurement.report("split Queue<vector>, partition()", REMOVE_QUEUE_SIZE);
+    sink = parts.first.size();
+}
+
+static const int COPY_SMALLEST_SIZE = 1000;
+static const int COPY_LARGEST_SIZE = 10000000;
+
+/** Copy construction and copy assignment of queues of 10^3 up to 10^7 items, about 10^7 items copied per size */
+static void copyQueues()
+{
+    for (int size = COPY_SMALLEST_SIZE; size <= COPY_LARGEST_SIZE; size *= 10){
+        Queue<int> q;
+        for (int i = 0; i < size; ++i){
+            q.pushBack(i);
+        }
+        int repeats = COPY_LARGEST_SIZE / size;
+        long long sum = 0;
+        Measurement construction;
+        for (int repeat = 0; repeat < repeats; ++repeat){
+            Queue<int> copyQ(q);
+            sum += copyQ.size();
+        }
+        construction.report("copy constructor, " + std::to_string(size) + " items",
+                            static_cast<long long>(size) * repeats);
+        Queue<int> target;
+        target.pushBack(0);
+        Measurement assignment;
+        for (int repeat = 0; repeat < repeats; ++repeat){
+            target = q;
+            sum += target.size();
+        }
+        assignment.report("copy assignment, " + std::to_string(size) + " items",
+                          static_cast<long long>(size) * repeats);
+        sink = sum;
+    }
+}
+
+static const int REFRESH_QUEUE_SIZE = 10000;
+static const int REFRESH_REPEATS = 200;
+
+/**
+ * @description: refreshes a snapshot of a queue of strings over and over, the source changing a little each time
+ * @param: assign - copies the source into the snapshot
+ */
+template <class ASSIGN>
+static void benchmarkRefresh(const std::string& name, ASSIGN assign)
+{
+    Queue<std::string> source;
+    for (int i = 0; i < REFRESH_QUEUE_SIZE; ++i){
+        source.pushBack(std::string(32, 'a' + i % 26));
+    }
+    Queue<std::string> snapshot(source);
+    Measurement measurement;
+    for (int repeat = 0; repeat < REFRESH_REPEATS; ++repeat){
+        source.front()[0] = 'a' + repeat % 26;
+        assign(snapshot, source);
+    }
+    measurement.report(name, static_cast<long long>(REFRESH_QUEUE_SIZE) * REFRESH_REPEATS);
+    sink = snapshot.size();
+}
+
+static void refreshByAssignment()
+{
+    benchmarkRefresh("refresh Queue<string> snapshot, operator=", [](Queue<std::string>& snapshot,
+                                                                    const Queue<std::string>& source)
+    {
+        snapshot = source;
+    });
+}
+
+static void refreshByAssignFrom()
+{
+    benchmarkRefresh("refresh Queue<string> snapshot, assignFrom()", [](Queue<std::string>& snapshot,
+                                                                       const Queue<std::string>& source)
+    {
+        snapshot.assignFrom(source);
+    });
+}
+
+static const int SNAPSHOT_QUEUE_SIZE = 100000;
+static const int SNAPSHOT_REPEATS = 100;
+
+/** Readers take a snapshot of the queue and iterate it once, and the queue changes between the snapshots */
+template <class QUEUE>
+static void benchmarkSnapshots(const std::string& name)
+{
+    QUEUE q;
+    for (int i = 0; i < SNAPSHOT_QUEUE_SIZE; ++i){
+        q.pushBack(i);
+    }
+    long long sum = 0;
+    Measurement measurement;
+    for (int repeat = 0; repeat < SNAPSHOT_REPEATS; ++repeat){
+        q.popFront();
+        q.pushBack(repeat);
+        const QUEUE snapshot(q);
+        for (const int& item : snapshot){
+            sum += item;
+        }
+    }
+    measurement.report(name, static_cast<long long>(SNAPSHOT_QUEUE_SIZE) * SNAPSHOT_REPEATS);
+    sink = sum;
+}
+
+static void snapshotQueue()
+{
+    benchmarkSnapshots<Queue<int>>("snapshot + scan, Queue copy");
+}
+
+static void snapshotCowQueue()
+{
+    benchmarkSnapshots<CowQueue<int>>("snapshot + scan, CowQueue copy");
+}
+
+static const int HISTORY_QUEUE_SIZE = 1000;
+static const int HISTORY_VERSIONS = 100000;
+
+/** Churns a queue and keeps every version, as an audit log would */
+static void historyPersistentQueue()
+{
+    PersistentQueue<int> q;
+    for (int i = 0; i < HISTORY_QUEUE_SIZE; ++i){
+        q = q.pushBack(i);
+    }
+    std::vector<PersistentQueue<int>> history;
+    history.reserve(HISTORY_VERSIONS);
+    Measurement measurement;
+    for (int i = 0; i < HISTORY_VERSIONS; ++i){
+        q = q.popFront().pushBack(i);
+        history.push_back(q);
+    }
+    measurement.report("keep every version, PersistentQueue", HISTORY_VERSIONS);
+    sink = history[HISTORY_VERSIONS / 2].front();
+}
+
+/** The same history kept as CowQueue copies, every change after a copy deep copies the queue */
+static void historyCowQueue()
+{
+    CowQueue<int> q;
+    for (int i = 0; i < HISTORY_QUEUE_SIZE; ++i){
+        q.pushBack(i);
+    }
+    std::vector<CowQueue<int>> history;
+    history.reserve(HISTORY_VERSIONS / 100);
+    Measurement measurement;
+    for (int i = 0; i < HISTORY_VERSIONS / 100; ++i){
+        q.popFront();
+        q.pushBack(i);
+        history.push_back(q);
+    }
+    measurement.report("keep every version, CowQueue", HISTORY_VERSIONS / 100);
+    sink = history[HISTORY_VERSIONS / 200].front();
+}
+
+static const int BATCH_SIZE = 256;
+static const int BATCH_ROUNDS = 20000;
+
+/**
+ * @description: a producer fills the queue with a batch and a consumer takes the whole batch, over and over
+ * @param: consume - takes up to BATCH_SIZE items out of the queue into the buffer
+ */
+template <class CONSUME>
+static void benchmarkBatches(const std::string& name, CONSUME consume)
+{
+    Queue<int> q;
+    int buffer[BATCH_SIZE];
+    long long sum = 0;
+    Measurement measurement;
+    for (int round = 0; round < BATCH_ROUNDS; ++round){
+        for (int i = 0; i < BATCH_SIZE; ++i){
+            q.pushBack(i);
+        }
+        int count = consume(q, buffer);
+        for (int i = 0; i < count; ++i){
+            sum += buffer[i];
+        }
+    }
+    measurement.report(name, static_cast<long long>(BATCH_SIZE) * BATCH_ROUNDS);
+    sink = sum;
+}
+
+static void batchFrontAndPop()
+{
+    benchmarkBatches("push + take 256 at once, front() + popFront()", [](Queue<int>& q, int* buffer)
+    {
+        int count = 0;
+        while (count < BATCH_SIZE && q.size() > 0){
+            buffer[count++] = q.front();
+            q.popFront();
+        }
+        return count;
+    });
+}
+
+static void batchDrainTo()
+{
+    benchmarkBatches("push + take 256 at once, drainTo()", [](Queue<int>& q, int* buffer)
+    {
+        return q.drainTo(buffer, BATCH_SIZE);
+    });
+}
+
+static const int PAGING_QUEUE_SIZE = 1000000;
+static const int PAGE_SIZE = 100;
+static const int PAGES = 200;
+
+/** Reads pages of 100 items from random places of a long queue, as a paging UI would */
+static void benchmarkPaging(const std::string& name, bool indexed)
+{
+    Queue<int> q;
+    for (int i = 0; i < PAGING_QUEUE_SIZE; ++i){
+        q.pushBack(i);
+    }
+    if (indexed){
+        q.enableIndex();
+    }
+    long long sum = 0;
+    unsigned int seed = 12345;
+    Measurement measurement;
+    for (int page = 0; page < PAGES; ++page){
+        seed = seed * 1103515245 + 12345;
+        int first = static_cast<int>(seed % (PAGING_QUEUE_SIZE - PAGE_SIZE));
+        Queue<int>::ConstIterator it = static_cast<const Queue<int>&>(q).iteratorAt(first);
+        for (int i = 0; i < PAGE_SIZE; ++i, ++it){
+            sum += *it;
+        }
+    }
+    measurement.report(name, PAGES);
+    sink = sum;
+}
+
+static void pagingWalk()
+{
+    benchmarkPaging("page of 100 out of 10^6, walk from the head", false);
+}
+
+static void pagingIndex()
+{
+    benchmarkPaging("page of 100 out of 10^6, indexed", true);
+}
+
+static const int KERNEL_QUEUE_SIZE = 1984 * 10000;
+static const int KERNEL_VALUES = 1000;
+static const int KERNEL_REPEATS = 5;
+
+static bool isSmall(int n)
+{
+    return n < KERNEL_VALUES / 2;
+}
+
+static void scaleAndShift(int& n)
+{
+    n = (n * 3 + 1) % KERNEL_VALUES;
+}
+
+/**
+ * @description: filters by a comparison and transforms by arithmetic over 1984 * 10^4 ints
+ * @note: the values are pseudo random, so a branch on the predicate can not be predicted
+ */
+template <class QUEUE>
+static void fillKernelQueue(QUEUE& q)
+{
+    unsigned int seed = 12345;
+    for (int i = 0; i < KERNEL_QUEUE_SIZE; ++i){
+        seed = seed * 1103515245 + 12345;
+        q.pushBack(static_cast<int>((seed >> 8) % KERNEL_VALUES));
+    }
+}
+
+template <class QUEUE>
+static void benchmarkKernels(const std::string& name)
+{
+    QUEUE q;
+    fillKernelQueue(q);
+    long long sum = 0;
+    Measurement filterMeasurement;
+    for (int repeat = 0; repeat < KERNEL_REPEATS; ++repeat){
+        sum += filter(q, isSmall).size();
+    }
+    filterMeasurement.report("filter " + name, static_cast<long long>(KERNEL_QUEUE_SIZE) * KERNEL_REPEATS);
+    Measurement transformMeasurement;
+    for (int repeat = 0; repeat < KERNEL_REPEATS; ++repeat){
+        transform(q, scaleAndShift);
+    }
+    transformMeasurement.report("transform " + name, static_cast<long long>(KERNEL_QUEUE_SIZE) * KERNEL_REPEATS);
+    sink = sum + q.front();
+}
+
+static void kernelsQueue()
+{
+    benchmarkKernels<Queue<int>>("Queue<int>");
+}
+
+static void kernelsUnrolledQueue()
+{
+    benchmarkKernels<UnrolledQueue<int>>("UnrolledQueue<int>");
+}
+
+static void kernelsArrayQueue()
+{
+    benchmarkKernels<ArrayQueue<int>>("ArrayQueue<int>");
+}
+
+/** The same filter as a CompareTo predicate, which the array-backed queues run with the vector kernels */
+template <class QUEUE>
+static void benchmarkComparisonFilter(const std::string& name)
+{
+    QUEUE q;
+    fillKernelQueue(q);
+    long long sum = 0;
+    Measurement measurement;
+    for (int repeat = 0; repeat < KERNEL_REPEATS; ++repeat){
+        sum += filter(q, lessThan(KERNEL_VALUES / 2)).size();
+    }
+    measurement.report("filter lessThan " + name, static_cast<long long>(KERNEL_QUEUE_SIZE) * KERNEL_REPEATS);
+    sink = sum;
+}
+
+static void comparisonUnrolledQueue()
+{
+    benchmarkComparisonFilter<UnrolledQueue<int>>("UnrolledQueue<int>");
+}
+
+static void comparisonArrayQueue()
+{
+    benchmarkComparisonFilter<ArrayQueue<int>>("ArrayQueue<int>");
+}
+
+static const long long MEMORY_SAMPLE_SIZE = 10000000;
+static const long long MEMORY_TARGET_SIZE = 1000000000;
+
+/**
+ * @description: fills a queue with small items and reports the bytes it asked for per item, and what the queue
+ *               comes to at 10^9 items
+ * @note: nothing is freed while the queue grows, so the bytes asked for are the bytes it holds. The allocator adds
+ *        its own header to every allocation on top of that, allocs/item tells how many of those there are
+ */
+template <class QUEUE>
+static void benchmarkMemory(const std::string& name, long long count)
+{
+    long long startBytes = allocatedBytes.load(std::memory_order_relaxed);
+    long long startAllocations = allocationCount.load(std::memory_order_relaxed);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    QUEUE q;
+    for (long long i = 0; i < count; ++i){
+        q.pushBack(static_cast<unsigned char>(i));
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    if (q.size() != static_cast<std::size_t>(count)){
+        std::cout << name << ": the queue holds " << q.size() << " items instead of " << count << std::endl;
+        return;
+    }
+    double bytesPerItem = static_cast<double>(allocatedBytes.load(std::memory_order_relaxed) - startBytes) / count;
+    long long allocations = allocationCount.load(std::memory_order_relaxed) - startAllocations;
+    std::cout << std::left << std::setw(56) << name
+              << std::right << std::setw(12) << std::fixed << std::setprecision(2)
+              << elapsed.count() / count << " ns/item"
+              << std::setw(10) << bytesPerItem << " bytes/item"
+              << std::setw(10) << static_cast<double>(allocations) / count << " allocs/item"
+              << std::setw(10) << bytesPerItem * MEMORY_TARGET_SIZE / 1e9 << " GB at 10^9" << std::endl;
+}
+
+static void memoryQueue()
+{
+    benchmarkMemory<Queue<int>>("memory, Queue<int>, 10^7 items", MEMORY_SAMPLE_SIZE);
+}
+
+static void memoryPoolQueue()
+{
+    benchmarkMemory<Queue<int, PoolAllocator<int>>>("memory, Queue<int> + PoolAllocator, 10^7 items",
+                                                    MEMORY_SAMPLE_SIZE);
+}
+
+static void memoryUnrolledQueue()
+{
+    benchmarkMemory<UnrolledQueue<int>>("memory, UnrolledQueue<int>, 10^7 items", MEMORY_SAMPLE_SIZE);
+}
+
+/** The only run at the full size, a Queue of 10^9 nodes would not fit in memory */
+static void memoryUnrolledQueueFull()
+{
+    benchmarkMemory<UnrolledQueue<unsigned char>>("memory, UnrolledQueue<unsigned char>, 10^9 items",
+                                                  MEMORY_TARGET_SIZE);
+}
+
+static const int SMALL_QUEUE_SIZE = 5;
+static const int SMALL_QUEUES_COUNT = 1000000;
+
+/** Many short-lived queues of a few items, as a queue of pending work kept on the stack of a function */
+template <class QUEUE>
+static void benchmarkSmallQueues(const std::string& name)
+{
+    Measurement measurement;
+    long long sum = 0;
+    for (int i = 0; i < SMALL_QUEUES_COUNT; ++i){
+        QUEUE q;
+        for (int j = 0; j < SMALL_QUEUE_SIZE; ++j){
+            q.pushBack(i + j);
+        }
+        while (q.size() != 0){
+            sum += q.front();
+            q.popFront();
+        }
+    }
+    measurement.report(name, static_cast<long long>(SMALL_QUEUES_COUNT) * SMALL_QUEUE_SIZE);
+    sink = sum;
+}
+
+struct Benchmark{
+    const char* name;
+    void (*run)();
+};
+
+static void churnDefaultAllocator()
+{
+    benchmarkChurn<Queue<int>>("churn push/pop, std::allocator");
+}
+
+static void churnPoolAllocator()
+{
+    benchmarkChurn<Queue<int, PoolAllocator<int>>>("churn push/pop, PoolAllocator");
+}
+
+static void churnIntrusiveQueue()
+{
+    benchmarkIntrusiveChurn("churn push/pop, IntrusiveQueue");
+}
+
+static void scanQueue()
+{
+    benchmarkScan<Queue<int>>("filter+transform, Queue");
+}
+
+static void scanUnrolledQueue()
+{
+    benchmarkScan<UnrolledQueue<int>>("filter+transform, UnrolledQueue");
+}
+
+static void scanArrayQueue()
+{
+    benchmarkScan<ArrayQueue<int>>("filter+transform, ArrayQueue");
+}
+
+static void churnArrayQueue()
+{
+    benchmarkChurn<ArrayQueue<int>>("churn push/pop, ArrayQueue");
+}
+
+static void smallQueue()
+{
+    benchmarkSmallQueues<Queue<int>>("5 items per queue, Queue");
+}
+
+static void smallSmallQueue()
+{
+    benchmarkSmallQueues<SmallQueue<int>>("5 items per queue, SmallQueue");
+}
+
+static const Benchmark benchmarks[] = {
+        {"churn", churnDefaultAllocator},
+        {"churn", churnPoolAllocator},
+        {"churn", churnArrayQueue},
+        {"churn", churnIntrusiveQueue},
+        {"scan", scanQueue},
+        {"scan", scanUnrolledQueue},
+        {"scan", scanArrayQueue},
+        {"view", pipelineMaterialized},
+        {"view", pipelineView},
+        {"remove", removeByFilter},
+        {"remove", removeByRemoveIf},
+        {"remove", removeByPartition},
+        {"paging", pagingWalk},
+        {"paging", pagingIndex},
+        {"batch", batchFrontAndPop},
+        {"batch", batchDrainTo},
+        {"copy", copyQueues},
+        {"copy", refreshByAssignment},
+        {"copy", refreshByAssignFrom},
+        {"copy", snapshotQueue},
+        {"copy", snapshotCowQueue},
+        {"copy", historyPersistentQueue},
+        {"copy", historyCowQueue},
+        {"spsc", handoffLockedQueue},
+        {"spsc", handoffSpscQueue},
+        {"spsc", pingPongLockedQueue},
+        {"spsc", pingPongSpscQueue},
+        {"mpmc", sharedLockedQueue},
+        {"mpmc", sharedConcurrentQueue},
+        {"pool", parallelLockedQueue},
+        {"pool", parallelThreadPool},
+        {"parallel", parallelFilter},
+        {"parallel", parallelTransform},
+        {"kernel", kernelsQueue},
+        {"kernel", kernelsUnrolledQueue},
+        {"kernel", kernelsArrayQueue},
+        {"kernel", comparisonUnrolledQueue},
+        {"kernel", comparisonArrayQueue},
+        {"memory", memoryQueue},
+        {"memory", memoryPoolQueue},
+        {"memory", memoryUnrolledQueue},
+        {"memory", memoryUnrolledQueueFull},
+        {"small", smallQueue},
+        {"small", smallSmallQueue},
+};
+
+/**
+ * Runs every benchmark, or only those whose name starts with one of the arguments
+ */
+int main(int argc, char** argv)
+{
+    for (const Benchmark& benchmark : benchmarks){
+        bool selected = (argc < 2);
+        for (int i = 1; i < argc; ++i){
+            if (std::strncmp(benchmark.name, argv[i], std::strlen(argv[i])) == 0){
+                selected = true;
+            }
+        }
+        if (selected){
+            benchmark.run();
+        }
+    }
+    return 0;
+}
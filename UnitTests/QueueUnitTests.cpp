@@ -1,8 +1,12 @@
 
 
+#include <cstddef>
+#include <limits>
 #include <string>
 #include <iostream>
 #include <vector>
+#include <memory>
+#include <type_traits>
 #include "catch.hpp"
 #include "relativeIncludes.h"
 
@@ -44,6 +48,97 @@ static void setSixtyNine(int& n)
     n = 69;
 }
 
+/** Counts its copies, to tell how much work a version or a move does */
+struct CopyCounter
+{
+    static int copies;
+    int m_value;
+
+    explicit CopyCounter(int value) : m_value(value) {}
+    CopyCounter(const CopyCounter& other) : m_value(other.m_value) { copies++; }
+    CopyCounter(CopyCounter&& other) : m_value(other.m_value) {}
+};
+
+int CopyCounter::copies = 0;
+
+std::string to_string(const CopyCounter& c)
+{
+    return std::to_string(c.m_value);
+}
+
+/**
+ * The "int Queue" scenario of Queue Basics, for the queues that keep the behavior of Queue<int>
+ * @tparam IntQueue: queue of ints with the interface of Queue<int>
+ */
+template <class IntQueue>
+void checkIntQueueScenario()
+{
+    IntQueue q;
+
+    REQUIRE(q.size() == 0);
+    REQUIRE(q.begin() == q.end());
+    REQUIRE_THROWS_AS(q.front(), typename IntQueue::EmptyQueue);
+    REQUIRE_THROWS_AS(q.popFront(), typename IntQueue::EmptyQueue);
+
+    q.pushBack(0);
+    REQUIRE(q.size() == 1);
+    REQUIRE(q.front() == 0);
+    q.front() = 1;
+    REQUIRE(q.front() == 1);
+
+    q.popFront();
+    REQUIRE(q.size() == 0);
+    REQUIRE(q.begin() == q.end());
+    REQUIRE_THROWS_AS(q.front(), typename IntQueue::EmptyQueue);
+    REQUIRE_THROWS_AS(q.popFront(), typename IntQueue::EmptyQueue);
+
+    for (int i = 0; i < 1984; i++){
+        q.pushBack(i);
+        REQUIRE(q.size() == static_cast<std::size_t>(i + 1));
+    }
+
+    IntQueue primesQ = filter(q, isPrime);
+    REQUIRE(primesQ.size() == 299);
+    for (int prime: primesQ)
+    {
+        REQUIRE(isPrime(prime));
+    }
+    REQUIRE(primesQ.front() == 2);
+
+    IntQueue sixtyNineQ = primesQ;
+    transform(sixtyNineQ, setSixtyNine);
+    REQUIRE(sixtyNineQ.size() == 299);
+    for (int sixtyNine: sixtyNineQ)
+    {
+        REQUIRE(sixtyNine == 69);
+    }
+    REQUIRE(primesQ.front() == 2); // The copy did not share the items it changed
+
+    const IntQueue constPrimesQ = filter(q, isPrime);
+    REQUIRE(constPrimesQ.size() == 299);
+    for (const int prime: constPrimesQ)
+    {
+        REQUIRE(isPrime(prime));
+    }
+    REQUIRE(constPrimesQ.front() == 2);
+
+    for (int i = 0; i < 1984; i++){
+        REQUIRE(q.front() == i);
+        q.popFront();
+        REQUIRE(q.size() == static_cast<std::size_t>(1983 - i));
+    }
+
+    typename IntQueue::Iterator endIterator = q.end();
+    REQUIRE_THROWS_AS(++endIterator, typename IntQueue::Iterator::InvalidOperation);
+    REQUIRE_THROWS_AS(*endIterator, typename IntQueue::Iterator::InvalidOperation);
+
+    typename IntQueue::ConstIterator constEndIterator = constPrimesQ.end();
+    REQUIRE_THROWS_AS(++constEndIterator, typename IntQueue::ConstIterator::InvalidOperation);
+
+    REQUIRE_THROWS_AS(q.front(), typename IntQueue::EmptyQueue);
+    REQUIRE_THROWS_AS(q.popFront(), typename IntQueue::EmptyQueue);
+}
+
 
 class ControlledAllocer{
 public:
@@ -100,7 +195,7 @@ TEST_CASE("Queue Basics")
         // Fill The Queue
         for (int i = 0; i < 1984; i++){
             q.pushBack(i);
-            REQUIRE(q.size() == i + 1);
+            REQUIRE(q.size() == static_cast<std::size_t>(i + 1));
         }
 
         Queue<int> primesQ = filter(q, isPrime);
@@ -132,7 +227,7 @@ TEST_CASE("Queue Basics")
         for (int i = 0; i < 1984; i++){
             REQUIRE(q.front() == i);
             q.popFront();
-            REQUIRE(q.size() == 1983 - i);
+            REQUIRE(q.size() == static_cast<std::size_t>(1983 - i));
         }
 
         Queue<int>::Iterator endIterator = q.end();
@@ -445,4 +540,885 @@ TEST_CASE("Queue Advanced")
         expected = "{1(5), 2(6), 3(7), 4(8), 5(9), 8(12), 7(9)}";
         REQUIRE(result == expected);
     }
-}
\ No newline at end of file
+}
+TEST_CASE("Queue Splice and Ranges")
+{
+    SECTION("splice")
+    {
+        Queue<int> q1, q2;
+        for (int i = 0; i < 5; ++i)
+        {
+            q1.pushBack(i);
+            q2.pushBack(i + 5);
+        }
+        q1.splice(std::move(q2));
+        REQUIRE(q1.size() == 10);
+        REQUIRE(q2.size() == 0);
+        REQUIRE_THROWS_AS(q2.front(), Queue<int>::EmptyQueue);
+
+        int expected = 0;
+        for (int item : q1)
+        {
+            REQUIRE(item == expected++);
+        }
+
+        // The tail must follow the spliced nodes
+        q1.pushBack(10);
+        q2.pushBack(20);
+        REQUIRE(q1.size() == 11);
+        REQUIRE(q2.front() == 20);
+
+        Queue<int> empty;
+        empty.splice(std::move(q1));
+        REQUIRE(empty.size() == 11);
+        REQUIRE(empty.front() == 0);
+        empty.splice(std::move(q1));
+        REQUIRE(empty.size() == 11);
+    }
+
+    SECTION("appendRange")
+    {
+        std::vector<int> items = {1, 2, 3, 4};
+        Queue<int> q;
+        q.pushBack(0);
+        q.appendRange(items.begin(), items.end()).pushBack(5);
+        REQUIRE(q.size() == 6);
+
+        std::string result;
+        readQueue(result, q);
+        REQUIRE(result == "{0, 1, 2, 3, 4, 5}");
+
+        q.appendRange(items.begin(), items.begin());
+        REQUIRE(q.size() == 6);
+    }
+
+    SECTION("appendRange Bad Alloc")
+    {
+        ControlledAllocer::allowedAllocs = 1000;
+        std::vector<ControlledAllocer> items(5);
+        Queue<ControlledAllocer> q;
+        q.pushBack(items[0]);
+        q.front().someInteger = 666;
+
+        ControlledAllocer::allowedAllocs = 3;
+        REQUIRE_THROWS_AS(q.appendRange(items.begin(), items.end()), std::bad_alloc);
+        REQUIRE(q.size() == 1);
+        REQUIRE(q.front().someInteger == 666);
+
+        ControlledAllocer::allowedAllocs = 1000;
+        q.pushBack(items[0]);
+        REQUIRE(q.size() == 2);
+    }
+}
+
+class DestructionCounter{
+public:
+    static int destructed;
+    int someInteger;
+
+    explicit DestructionCounter(int value = 0) : someInteger(value) {}
+    DestructionCounter(const DestructionCounter &other) = default;
+    ~DestructionCounter()
+    {
+        ++destructed;
+    }
+};
+int DestructionCounter::destructed;
+
+struct alignas(16) WideAligned{
+    double values[4];
+};
+
+TEST_CASE("Queue Node Storage")
+{
+    SECTION("Items are destroyed exactly once")
+    {
+        DestructionCounter::destructed = 0;
+        {
+            Queue<DestructionCounter> q;
+            DestructionCounter item(7);
+            for (int i = 0; i < 10; ++i)
+            {
+                q.pushBack(item);
+            }
+            q.popFront();
+            q.popFront();
+            REQUIRE(DestructionCounter::destructed == 2);
+            REQUIRE(q.front().someInteger == 7);
+        }
+        REQUIRE(DestructionCounter::destructed == 11); // 10 items and the local one
+    }
+
+    SECTION("Items are stored aligned")
+    {
+        Queue<WideAligned> q;
+        for (int i = 0; i < 8; ++i)
+        {
+            q.pushBack(WideAligned());
+        }
+        for (const WideAligned& item : q)
+        {
+            REQUIRE(reinterpret_cast<std::uintptr_t>(&item) % alignof(WideAligned) == 0);
+        }
+    }
+}
+
+TEST_CASE("Queue Move Semantics")
+{
+    SECTION("Move-only items")
+    {
+        Queue<std::unique_ptr<int>> q;
+        q.pushBack(std::unique_ptr<int>(new int(1)));
+        q.emplaceBack(new int(2));
+        q.emplaceBack();
+        REQUIRE(q.size() == 3);
+        REQUIRE(*q.front() == 1);
+
+        std::unique_ptr<int> out;
+        q.popFront(out);
+        REQUIRE(*out == 1);
+        q.popFront(out);
+        REQUIRE(*out == 2);
+        REQUIRE(q.size() == 1);
+        REQUIRE(q.front() == nullptr);
+        q.popFront();
+        REQUIRE_THROWS_AS(q.popFront(out), Queue<std::unique_ptr<int>>::EmptyQueue);
+        REQUIRE(*out == 2);
+    }
+
+    SECTION("Move constructor, move assignment and swap")
+    {
+        Queue<std::vector<int>> q1;
+        q1.emplaceBack(3, 7);
+        q1.pushBack(std::vector<int>(2, 8));
+        const int* firstData = q1.front().data();
+
+        Queue<std::vector<int>> q2(std::move(q1));
+        REQUIRE(q1.size() == 0);
+        REQUIRE(q2.size() == 2);
+        REQUIRE(q2.front().data() == firstData);
+        q1.pushBack(std::vector<int>(1, 1));
+        REQUIRE(q1.size() == 1);
+
+        q1 = std::move(q2);
+        REQUIRE(q2.size() == 0);
+        REQUIRE(q1.size() == 2);
+        REQUIRE(q1.front().data() == firstData);
+        q2.pushBack(std::vector<int>(1, 9));
+
+        swap(q1, q2);
+        REQUIRE(q1.size() == 1);
+        REQUIRE(q1.front()[0] == 9);
+        REQUIRE(q2.size() == 2);
+        REQUIRE(q2.front().size() == 3);
+
+        std::vector<int> out;
+        q2.popFront(out);
+        REQUIRE(out.data() == firstData);
+        REQUIRE(q2.front().size() == 2);
+        q2.pushBack(out);
+        REQUIRE(q2.size() == 2);
+    }
+}
+
+TEST_CASE("Queue Pool Allocator")
+{
+    typedef PoolAllocator<int, 16> IntPool;
+    typedef Queue<int, IntPool> PooledQueue;
+
+    SECTION("Nodes are recycled")
+    {
+        PooledQueue q;
+        for (int i = 0; i < 16; ++i)
+        {
+            q.pushBack(i);
+        }
+        REQUIRE(q.get_allocator().blockCount() == 1);
+
+        q.popFront();
+        q.pushBack(16);
+        int last = 0;
+        for (int item : q)
+        {
+            last = item;
+        }
+        REQUIRE(last == 16);
+        REQUIRE(q.get_allocator().blockCount() == 1);
+
+        // Steady state churn never asks for another block
+        for (int i = 0; i < 1000; ++i)
+        {
+            q.popFront();
+            q.pushBack(i);
+        }
+        REQUIRE(q.get_allocator().blockCount() == 1);
+        REQUIRE(q.size() == 16);
+
+        q.pushBack(17);
+        REQUIRE(q.get_allocator().blockCount() == 2);
+    }
+
+    SECTION("Same semantics as the default allocator")
+    {
+        PooledQueue q;
+        for (int i = 0; i < 1984; i++)
+        {
+            q.pushBack(i);
+        }
+        PooledQueue primesQ = filter(q, isPrime);
+        REQUIRE(primesQ.size() == 299);
+        REQUIRE(primesQ.front() == 2);
+
+        PooledQueue copyQ(primesQ);
+        transform(copyQ, setSixtyNine);
+        REQUIRE(copyQ.front() == 69);
+        REQUIRE(primesQ.front() == 2);
+
+        copyQ = primesQ;
+        REQUIRE(copyQ.size() == 299);
+        REQUIRE(copyQ.front() == 2);
+
+        // A filtered queue shares the pool of its source, so splicing it only relinks
+        REQUIRE(primesQ.get_allocator() == q.get_allocator());
+        const int* spliced = &primesQ.front();
+        q.splice(std::move(primesQ));
+        REQUIRE(q.size() == 1984 + 299);
+        int count = 0;
+        for (const int& item : q)
+        {
+            if (count++ == 1984)
+            {
+                REQUIRE(&item == spliced);
+            }
+        }
+
+        // Queues with different pools can still be spliced, by moving the items
+        PooledQueue other;
+        other.pushBack(-1);
+        REQUIRE(other.get_allocator() != q.get_allocator());
+        q.splice(std::move(other));
+        REQUIRE(other.size() == 0);
+        REQUIRE(q.size() == 1984 + 300);
+
+        REQUIRE_THROWS_AS(other.popFront(), PooledQueue::EmptyQueue);
+    }
+
+    SECTION("Queues built from one allocator share its pools")
+    {
+        IntPool pool;
+        PooledQueue a(pool);
+        PooledQueue b(pool);
+        REQUIRE(a.get_allocator() == pool);
+        REQUIRE(b.get_allocator() == a.get_allocator());
+
+        for (int i = 0; i < 10; ++i)
+        {
+            a.pushBack(i);
+            b.pushBack(i + 10);
+        }
+        REQUIRE(pool.blockCount() == 2);
+
+        // Equal allocators, so splicing only relinks the nodes
+        const int* spliced = &b.front();
+        a.splice(std::move(b));
+        REQUIRE(a.size() == 20);
+        REQUIRE(b.size() == 0);
+        REQUIRE(pool.blockCount() == 2);
+        int count = 0;
+        for (const int& item : a)
+        {
+            if (count++ == 10)
+            {
+                REQUIRE(&item == spliced);
+            }
+        }
+
+        // A copy may move to another thread, so it gets pools of its own
+        PooledQueue copy(a);
+        REQUIRE(copy.get_allocator() != pool);
+        REQUIRE(copy.get_allocator().blockCount() == 2);
+        REQUIRE(pool.blockCount() == 2);
+    }
+
+    SECTION("Bad Allocs")
+    {
+        ControlledAllocer::allowedAllocs = 1000;
+        Queue<ControlledAllocer, PoolAllocator<ControlledAllocer>> q1, q2;
+        ControlledAllocer c;
+        for (int i = 0; i < 10; i++)
+        {
+            q1.pushBack(c);
+        }
+        q1.front().someInteger = 666;
+
+        ControlledAllocer::allowedAllocs = 0;
+        REQUIRE_THROWS_AS(q1.pushBack(c), std::bad_alloc);
+        ControlledAllocer::allowedAllocs = 5;
+        REQUIRE_THROWS_AS(q1 = q2 = q1, std::bad_alloc);
+        REQUIRE(q1.size() == 10);
+        REQUIRE(q2.size() == 0);
+        REQUIRE(q1.front().someInteger == 666);
+    }
+}
+
+TEST_CASE("Queue Remove and Partition")
+{
+    Queue<int> q;
+    for (int i = 0; i < 1984; i++)
+    {
+        q.pushBack(i);
+    }
+
+    SECTION("removeIf")
+    {
+        Queue<int> primesQ = filter(q, isPrime);
+        REQUIRE(q.removeIf([](int n) { return !isPrime(n); }) == 1984 - 299);
+        REQUIRE(q.size() == 299);
+        Queue<int>::Iterator expected = primesQ.begin();
+        bool same = true;
+        for (int prime : q)
+        {
+            same = same && prime == *expected;
+            ++expected;
+        }
+        REQUIRE(same);
+
+        // The tail is kept when the last nodes are removed
+        std::string result;
+        Queue<int> lastQ;
+        lastQ.pushBack(1).pushBack(2).pushBack(3);
+        REQUIRE(lastQ.removeIf([](int n) { return n != 2; }) == 2);
+        lastQ.pushBack(4);
+        readQueue(result, lastQ);
+        REQUIRE(result == "{2, 4}");
+
+        REQUIRE(q.removeIf([](int) { return true; }) == 299);
+        REQUIRE(q.size() == 0);
+        REQUIRE_THROWS_AS(q.front(), Queue<int>::EmptyQueue);
+        q.pushBack(7);
+        REQUIRE(q.front() == 7);
+    }
+
+    SECTION("removeIf relinks without copying")
+    {
+        Queue<std::vector<int>> vectorsQ;
+        for (int i = 0; i < 10; i++)
+        {
+            vectorsQ.pushBack(std::vector<int>(100, i));
+        }
+        const int* keptData = vectorsQ.front().data();
+        vectorsQ.removeIf([](const std::vector<int>& items) { return items[0] % 2 == 1; });
+        REQUIRE(vectorsQ.size() == 5);
+        REQUIRE(vectorsQ.front().data() == keptData);
+
+        Queue<DestructionCounter> counters;
+        for (int i = 0; i < 6; i++)
+        {
+            counters.emplaceBack(i);
+        }
+        int before = DestructionCounter::destructed;
+        counters.removeIf([](const DestructionCounter& counter) { return counter.someInteger < 4; });
+        REQUIRE(DestructionCounter::destructed == before + 4);
+    }
+
+    SECTION("partition")
+    {
+        const int* firstPrime = nullptr;
+        for (const int& item : q)
+        {
+            if (item == 2)
+            {
+                firstPrime = &item;
+            }
+        }
+        std::pair<Queue<int>, Queue<int>> parts = q.partition(isPrime);
+        REQUIRE(q.size() == 0);
+        REQUIRE(parts.first.size() == 299);
+        REQUIRE(parts.second.size() == 1984 - 299);
+        REQUIRE(&parts.first.front() == firstPrime);
+        REQUIRE(parts.second.front() == 0);
+
+        int previous = -1;
+        bool ordered = true;
+        for (int prime : parts.first)
+        {
+            ordered = ordered && isPrime(prime) && prime > previous;
+            previous = prime;
+        }
+        previous = -1;
+        for (int other : parts.second)
+        {
+            ordered = ordered && !isPrime(other) && other > previous;
+            previous = other;
+        }
+        REQUIRE(ordered);
+
+        parts.first.pushBack(2000);
+        parts.second.pushBack(2001);
+        q.pushBack(1);
+        REQUIRE(parts.first.size() == 300);
+        REQUIRE(q.front() == 1);
+    }
+
+    SECTION("partition keeps every item if the predicate throws")
+    {
+        Queue<int> small;
+        small.pushBack(1).pushBack(2).pushBack(3).pushBack(4).pushBack(5);
+        REQUIRE_THROWS_AS(small.partition([](int n)
+        {
+            if (n == 4)
+            {
+                throw std::bad_alloc();
+            }
+            return n % 2 == 0;
+        }), std::bad_alloc);
+        std::string result;
+        readQueue(result, small);
+        REQUIRE(result == "{1, 2, 3, 4, 5}");
+        small.pushBack(6);
+        REQUIRE(small.size() == 6);
+    }
+
+    SECTION("partition with a pool allocator")
+    {
+        typedef Queue<int, PoolAllocator<int>> PooledQueue;
+        PooledQueue pooled;
+        for (int i = 0; i < 100; i++)
+        {
+            pooled.pushBack(i);
+        }
+        std::pair<PooledQueue, PooledQueue> parts = pooled.partition(isPrime);
+        REQUIRE(parts.first.size() == 25);
+        REQUIRE(parts.first.get_allocator() == pooled.get_allocator());
+        REQUIRE(pooled.get_allocator().blockCount() == 1);
+    }
+}
+
+TEST_CASE("Queue Copy")
+{
+    SECTION("Copies keep their tail")
+    {
+        Queue<int> q;
+        for (int i = 0; i < 1000; i++)
+        {
+            q.pushBack(i);
+        }
+        Queue<int> copyQ(q);
+        copyQ.pushBack(1000);
+        REQUIRE(copyQ.size() == 1001);
+        REQUIRE(q.size() == 1000);
+
+        Queue<int> assignedQ;
+        assignedQ.pushBack(-1);
+        assignedQ = copyQ;
+        assignedQ.pushBack(1001);
+        int expected = 0;
+        bool same = true;
+        for (int item : assignedQ)
+        {
+            same = same && item == expected++;
+        }
+        REQUIRE(same);
+        REQUIRE(assignedQ.size() == 1002);
+
+        Queue<int> empty;
+        assignedQ = empty;
+        REQUIRE(assignedQ.size() == 0);
+        REQUIRE_THROWS_AS(assignedQ.front(), Queue<int>::EmptyQueue);
+        assignedQ.pushBack(5);
+        REQUIRE(assignedQ.front() == 5);
+    }
+
+    SECTION("Assignment that fails midway changes nothing")
+    {
+        ControlledAllocer::allowedAllocs = 1000;
+        Queue<ControlledAllocer> source, target;
+        for (int i = 0; i < 10; i++)
+        {
+            source.pushBack(ControlledAllocer());
+        }
+        target.pushBack(ControlledAllocer());
+        target.front().someInteger = 666;
+        ControlledAllocer::allowedAllocs = 5;
+        REQUIRE_THROWS_AS(target = source, std::bad_alloc);
+        REQUIRE(target.size() == 1);
+        REQUIRE(target.front().someInteger == 666);
+        REQUIRE_THROWS_AS(Queue<ControlledAllocer>(source), std::bad_alloc);
+
+        ControlledAllocer::allowedAllocs = 1000;
+        target = source;
+        REQUIRE(target.size() == 10);
+    }
+}
+
+TEST_CASE("Queue assignFrom")
+{
+    Queue<int> q;
+    for (int i = 0; i < 10; i++)
+    {
+        q.pushBack(i);
+    }
+
+    SECTION("Same size reuses every node")
+    {
+        Queue<int> target;
+        for (int i = 0; i < 10; i++)
+        {
+            target.pushBack(-i);
+        }
+        const int* firstItem = &target.front();
+        target.assignFrom(q);
+        REQUIRE(&target.front() == firstItem);
+        std::string result;
+        readQueue(result, target);
+        REQUIRE(result == "{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}");
+    }
+
+    SECTION("Longer and shorter sources")
+    {
+        Queue<int> target;
+        target.pushBack(-1).pushBack(-2);
+        const int* firstItem = &target.front();
+        target.assignFrom(q).pushBack(10);
+        REQUIRE(target.size() == 11);
+        REQUIRE(&target.front() == firstItem);
+
+        Queue<int> shortQ;
+        shortQ.pushBack(7).pushBack(8);
+        target.assignFrom(shortQ).pushBack(9);
+        std::string result;
+        readQueue(result, target);
+        REQUIRE(result == "{7, 8, 9}");
+
+        Queue<int> empty;
+        target.assignFrom(empty);
+        REQUIRE(target.size() == 0);
+        REQUIRE_THROWS_AS(target.front(), Queue<int>::EmptyQueue);
+        target.assignFrom(shortQ).assignFrom(target);
+        REQUIRE(target.size() == 2);
+        REQUIRE(target.front() == 7);
+    }
+
+    SECTION("Only the difference is allocated and freed")
+    {
+        Queue<DestructionCounter> source, target;
+        for (int i = 0; i < 5; i++)
+        {
+            source.emplaceBack(i);
+            target.emplaceBack(i + 10);
+        }
+        target.emplaceBack(15).emplaceBack(16);
+        int before = DestructionCounter::destructed;
+        target.assignFrom(source);
+        REQUIRE(DestructionCounter::destructed == before + 2);
+        REQUIRE(target.size() == 5);
+        REQUIRE(target.front().someInteger == 0);
+    }
+
+    SECTION("Failed allocation changes nothing")
+    {
+        ControlledAllocer::allowedAllocs = 1000;
+        Queue<ControlledAllocer> source, target;
+        for (int i = 0; i < 10; i++)
+        {
+            source.pushBack(ControlledAllocer());
+        }
+        target.pushBack(ControlledAllocer());
+        target.front().someInteger = 666;
+
+        ControlledAllocer::allowedAllocs = 5;
+        REQUIRE_THROWS_AS(target.assignFrom(source), std::bad_alloc);
+        REQUIRE(target.size() == 1);
+        REQUIRE(target.front().someInteger == 666);
+
+        ControlledAllocer::allowedAllocs = 1000;
+        target.assignFrom(source);
+        REQUIRE(target.size() == 10);
+    }
+}
+
+TEST_CASE("Queue Batch Pop")
+{
+    Queue<int> q;
+    for (int i = 0; i < 10; i++)
+    {
+        q.pushBack(i);
+    }
+
+    SECTION("popFrontBatch")
+    {
+        REQUIRE(q.popFrontBatch(3) == 3);
+        REQUIRE(q.size() == 7);
+        REQUIRE(q.front() == 3);
+        REQUIRE(q.popFrontBatch(0) == 0);
+        REQUIRE(q.popFrontBatch(100) == 7);
+        REQUIRE(q.size() == 0);
+        REQUIRE(q.popFrontBatch(5) == 0);
+        q.pushBack(1);
+        REQUIRE(q.front() == 1);
+    }
+
+    SECTION("counts are not limited to int")
+    {
+        static_assert(std::is_same<decltype(q.size()), std::size_t>::value, "sizes of a Queue are size_t");
+        std::size_t beyondInt = static_cast<std::size_t>(std::numeric_limits<int>::max()) + 1;
+        REQUIRE(q.popFrontBatch(beyondInt) == 10);
+        REQUIRE(q.size() == 0);
+        q.pushBack(1);
+        REQUIRE_THROWS_AS(q.at(beyondInt), Queue<int>::InvalidPosition);
+        REQUIRE_THROWS_AS(q.iteratorAt(beyondInt), Queue<int>::InvalidPosition);
+    }
+
+    SECTION("drainTo")
+    {
+        std::vector<int> drained;
+        REQUIRE(q.drainTo(std::back_inserter(drained), 4) == 4);
+        REQUIRE(drained.size() == 4);
+        REQUIRE(drained[3] == 3);
+        REQUIRE(q.front() == 4);
+
+        int buffer[256];
+        REQUIRE(q.drainTo(buffer, 256) == 6);
+        REQUIRE(buffer[0] == 4);
+        REQUIRE(buffer[5] == 9);
+        REQUIRE(q.size() == 0);
+        REQUIRE(q.drainTo(buffer, 256) == 0);
+        q.pushBack(10).pushBack(11);
+        std::string result;
+        readQueue(result, q);
+        REQUIRE(result == "{10, 11}");
+    }
+
+    SECTION("drainTo moves the items")
+    {
+        Queue<std::vector<int>> vectorsQ;
+        vectorsQ.pushBack(std::vector<int>(100, 1)).pushBack(std::vector<int>(100, 2));
+        const int* data = vectorsQ.front().data();
+        std::vector<std::vector<int>> drained;
+        REQUIRE(vectorsQ.drainTo(std::back_inserter(drained), 1) == 1);
+        REQUIRE(drained[0].data() == data);
+        REQUIRE(vectorsQ.front()[0] == 2);
+    }
+
+    SECTION("drainTo removes what it moved before a throw")
+    {
+        ControlledAllocer::allowedAllocs = 1000;
+        Queue<ControlledAllocer> controlledQ;
+        for (int i = 0; i < 5; i++)
+        {
+            controlledQ.pushBack(ControlledAllocer());
+        }
+        std::vector<ControlledAllocer> buffer(5);
+        ControlledAllocer::allowedAllocs = 2;
+        REQUIRE_THROWS_AS(controlledQ.drainTo(buffer.begin(), 5), std::bad_alloc);
+        REQUIRE(controlledQ.size() == 3);
+        ControlledAllocer::allowedAllocs = 1000;
+        REQUIRE(controlledQ.drainTo(buffer.begin(), 5) == 3);
+        REQUIRE(controlledQ.size() == 0);
+        controlledQ.pushBack(ControlledAllocer());
+        REQUIRE(controlledQ.size() == 1);
+    }
+}
+
+TEST_CASE("Queue Bulk Insertion")
+{
+    SECTION("initializer_list")
+    {
+        Queue<int> q = {1, 2, 3};
+        REQUIRE(q.size() == 3);
+        q.pushBack(4);
+        std::string result;
+        readQueue(result, q);
+        REQUIRE(result == "{1, 2, 3, 4}");
+
+        Queue<int> empty = {};
+        REQUIRE(empty.size() == 0);
+
+        q.pushBack({5, 6}).pushBack({});
+        REQUIRE(q.size() == 6);
+
+        typedef Queue<int, PoolAllocator<int>> PooledQueue;
+        PoolAllocator<int> pool;
+        PooledQueue pooled({7, 8, 9}, pool);
+        REQUIRE(pooled.size() == 3);
+        REQUIRE(pooled.front() == 7);
+    }
+
+    SECTION("Ranges")
+    {
+        std::vector<int> items = {1, 2, 3};
+        Queue<int> q;
+        q.pushBack(items.begin(), items.end()).pushBack(items.begin(), items.begin());
+        REQUIRE(q.size() == 3);
+
+        Queue<std::string> names;
+        const char* words[] = {"pushBack", "from", "pointers"};
+        names.pushBack(words, words + 3).pushBack("end");
+        REQUIRE(names.size() == 4);
+        REQUIRE(names.front() == "pushBack");
+    }
+
+    SECTION("A failed batch changes nothing")
+    {
+        ControlledAllocer::allowedAllocs = 1000;
+        std::vector<ControlledAllocer> items(5);
+        Queue<ControlledAllocer> q;
+        q.pushBack(items[0]);
+        q.front().someInteger = 666;
+
+        ControlledAllocer::allowedAllocs = 4;
+        REQUIRE_THROWS_AS(q.pushBack(items.begin(), items.end()), std::bad_alloc);
+        REQUIRE(q.size() == 1);
+        REQUIRE(q.front().someInteger == 666);
+
+        ControlledAllocer::allowedAllocs = 1;
+        REQUIRE_THROWS_AS(Queue<ControlledAllocer>({items[0], items[1]}), std::bad_alloc);
+
+        ControlledAllocer::allowedAllocs = 1000;
+        q.pushBack(items.begin(), items.end());
+        REQUIRE(q.size() == 6);
+    }
+}
+
+/** Checks at() and iteratorAt() of every position against a walk from the head */
+template <class T, class Alloc>
+bool positionsMatchWalk(const Queue<T, Alloc>& q)
+{
+    int position = 0;
+    for (typename Queue<T, Alloc>::ConstIterator it = q.begin(); it != q.end(); ++it, ++position)
+    {
+        if (&q.at(position) != &*it || &*q.iteratorAt(position) != &*it)
+        {
+            return false;
+        }
+    }
+    return q.iteratorAt(q.size()) == q.end();
+}
+
+TEST_CASE("Queue Positional Access")
+{
+    Queue<int> q;
+    for (int i = 0; i < 1000; i++)
+    {
+        q.pushBack(i);
+    }
+
+    SECTION("Iterator operator+")
+    {
+        Queue<int>::Iterator it = q.begin();
+        REQUIRE(*(it + 0) == 0);
+        REQUIRE(*(it + 5) == 5);
+        REQUIRE(*it == 0);
+        REQUIRE(it + 1000 == q.end());
+        REQUIRE_THROWS_AS(it + 1001, Queue<int>::Iterator::InvalidOperation);
+        REQUIRE_THROWS_AS(it + -1, Queue<int>::Iterator::InvalidOperation);
+
+        const Queue<int>& constQ = q;
+        Queue<int>::ConstIterator constIt = constQ.begin();
+        REQUIRE(*(constIt + 999) == 999);
+        REQUIRE(*constIt == 0);
+        REQUIRE(constIt + 1000 == constQ.end());
+    }
+
+    SECTION("Without an index")
+    {
+        REQUIRE_FALSE(q.isIndexed());
+        REQUIRE(q.at(0) == 0);
+        REQUIRE(q.at(999) == 999);
+        REQUIRE_THROWS_AS(q.at(1000), Queue<int>::InvalidPosition);
+        REQUIRE_THROWS_AS(q.at(-1), Queue<int>::InvalidPosition);
+        REQUIRE_THROWS_AS(q.iteratorAt(1001), Queue<int>::InvalidPosition);
+        REQUIRE(positionsMatchWalk(q));
+    }
+
+    SECTION("pushBack and popFront keep the index")
+    {
+        q.enableIndex(7);
+        REQUIRE(q.isIndexed());
+        REQUIRE(positionsMatchWalk(q));
+        for (int i = 0; i < 100; i++)
+        {
+            q.popFront();
+            q.pushBack(1000 + i);
+            q.emplaceBack(2000 + i);
+        }
+        REQUIRE(q.size() == 1100);
+        REQUIRE(q.at(0) == 100);
+        REQUIRE(positionsMatchWalk(q));
+
+        while (q.size() > 0)
+        {
+            q.popFront();
+        }
+        REQUIRE_THROWS_AS(q.at(0), Queue<int>::InvalidPosition);
+        q.pushBack(1).pushBack(2);
+        REQUIRE(q.at(1) == 2);
+        REQUIRE(positionsMatchWalk(q));
+
+        q.disableIndex();
+        REQUIRE_FALSE(q.isIndexed());
+        REQUIRE(q.at(1) == 2);
+    }
+
+    SECTION("Other changes keep the index")
+    {
+        q.enableIndex(16);
+        q.removeIf([](int n) { return n % 3 == 0; });
+        REQUIRE(positionsMatchWalk(q));
+        REQUIRE(q.popFrontBatch(50) == 50);
+        REQUIRE(positionsMatchWalk(q));
+        int buffer[10];
+        q.drainTo(buffer, 10);
+        REQUIRE(positionsMatchWalk(q));
+
+        Queue<int> other = {1, 2, 3};
+        q.splice(std::move(other)).pushBack({4, 5});
+        REQUIRE(positionsMatchWalk(q));
+
+        Queue<int> shortQ = {7, 8, 9};
+        q.assignFrom(shortQ);
+        REQUIRE(q.at(2) == 9);
+        REQUIRE(positionsMatchWalk(q));
+
+        Queue<int> longQ;
+        for (int i = 0; i < 300; i++)
+        {
+            longQ.pushBack(i);
+        }
+        q.assignFrom(longQ);
+        REQUIRE(positionsMatchWalk(q));
+        q = shortQ;
+        REQUIRE(positionsMatchWalk(q));
+        q = longQ;
+        REQUIRE(q.at(299) == 299);
+
+        Queue<int> copyQ(q);
+        REQUIRE(copyQ.isIndexed());
+        REQUIRE(positionsMatchWalk(copyQ));
+
+        swap(copyQ, longQ);
+        REQUIRE_FALSE(copyQ.isIndexed());
+        REQUIRE(longQ.isIndexed());
+        REQUIRE(positionsMatchWalk(longQ));
+
+        std::pair<Queue<int>, Queue<int>> parts = q.partition(isPrime);
+        REQUIRE(q.size() == 0);
+        q.pushBack(1);
+        REQUIRE(positionsMatchWalk(q));
+        REQUIRE(parts.first.size() == 62);
+    }
+
+    SECTION("Parallel work splits through the index")
+    {
+        Queue<int> numbersQ;
+        for (int i = 0; i < 1984; i++)
+        {
+            numbersQ.pushBack(i);
+        }
+        numbersQ.enableIndex();
+        Queue<int> primesQ = filter(numbersQ, isPrime, 5);
+        REQUIRE(primesQ.size() == 299);
+        transform(numbersQ, setSixtyNine, 3);
+        REQUIRE(numbersQ.at(1983) == 69);
+    }
+}
@@ -0,0 +1,230 @@
+#ifndef QUEUE_VIEWS_H
+#define QUEUE_VIEWS_H
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include "Queue.h"
+
+/**
+ * @brief: lazy views over a queue, such as q | filtered(isPrime) | transformed(square)
+ *
+ * @note: a view copies no items. Its iterator pulls the items out of the queue one at a time and passes them through
+ *        every stage, so a chain of stages is a single pass that allocates nothing, until toQueue() is called.
+ * @note: a view refers to the queue it was made from, which must outlive it and stay unchanged while it is iterated
+ * @note: a filter placed after a transform calls the transform function twice on the items that pass, once for the
+ *        predicate and once for the item itself
+ */
+
+/** Base of the views, stages keep other views by value and queues by reference */
+class QueueView {};
+
+template<class RANGE>
+struct ViewStorage {
+    typedef typename std::conditional<std::is_base_of<QueueView, RANGE>::value, RANGE, const RANGE&>::type type;
+};
+
+template<class RANGE>
+struct RangeTraits {
+    typedef decltype(std::declval<const RANGE&>().begin()) Iterator;
+    typedef decltype(*std::declval<const Iterator&>()) reference;
+    typedef typename std::decay<reference>::type value_type;
+};
+
+/**
+ * @description: copies the items of the view into a new queue
+ * @return: a queue holding the items the view yields, in the same order
+ */
+template<class VIEW>
+Queue<typename RangeTraits<VIEW>::value_type> materialize(const VIEW& view) {
+    Queue<typename RangeTraits<VIEW>::value_type> newQueue;
+    for (auto i = view.begin(); i != view.end(); ++i) {
+        newQueue.pushBack(*i);
+    }
+    return newQueue;
+}
+
+/**
+ * @brief: FilteredView class, yields only the items of the range that the predicate accepts
+ */
+template<class RANGE, class PRED>
+class FilteredView : public QueueView {
+private:
+    typedef typename RangeTraits<RANGE>::Iterator SourceIterator;
+
+    typename ViewStorage<RANGE>::type m_range;
+    PRED m_predicate;
+
+public:
+    class Iterator {
+    private:
+        SourceIterator m_current;
+        SourceIterator m_end;
+        const PRED* m_predicate;
+
+        void skipRejected() {
+            while (m_current != m_end && !((*m_predicate)(*m_current))) {
+                ++m_current;
+            }
+        }
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef typename RangeTraits<RANGE>::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const value_type* pointer;
+        typedef typename RangeTraits<RANGE>::reference reference;
+
+        Iterator(SourceIterator current, SourceIterator end, const PRED* predicate) :
+                m_current(current), m_end(end), m_predicate(predicate) {
+            skipRejected();
+        }
+
+        reference operator*() const {
+            return *m_current;
+        }
+
+        Iterator& operator++() {
+            ++m_current;
+            skipRejected();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return m_current == other.m_current;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return !(*this == other);
+        }
+    };
+
+    FilteredView(const RANGE& range, PRED predicate) : m_range(range), m_predicate(std::move(predicate)) {}
+
+    Iterator begin() const {
+        return Iterator(m_range.begin(), m_range.end(), &m_predicate);
+    }
+
+    Iterator end() const {
+        return Iterator(m_range.end(), m_range.end(), &m_predicate);
+    }
+
+    Queue<typename RangeTraits<RANGE>::value_type> toQueue() const {
+        return materialize(*this);
+    }
+};
+
+/**
+ * @brief: TransformedView class, yields the result of the function on every item of the range
+ * @note: the items of the range are not changed, the function is called on every dereference
+ */
+template<class RANGE, class FUNC>
+class TransformedView : public QueueView {
+private:
+    typedef typename RangeTraits<RANGE>::Iterator SourceIterator;
+    typedef decltype(std::declval<const FUNC&>()(std::declval<typename RangeTraits<RANGE>::reference>())) Result;
+
+    typename ViewStorage<RANGE>::type m_range;
+    FUNC m_function;
+
+public:
+    class Iterator {
+    private:
+        SourceIterator m_current;
+        const FUNC* m_function;
+
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef typename std::decay<Result>::type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const value_type* pointer;
+        typedef Result reference;
+
+        Iterator(SourceIterator current, const FUNC* function) : m_current(current), m_function(function) {}
+
+        reference operator*() const {
+            return (*m_function)(*m_current);
+        }
+
+        Iterator& operator++() {
+            ++m_current;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return m_current == other.m_current;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return !(*this == other);
+        }
+    };
+
+    TransformedView(const RANGE& range, FUNC function) : m_range(range), m_function(std::move(function)) {}
+
+    Iterator begin() const {
+        return Iterator(m_range.begin(), &m_function);
+    }
+
+    Iterator end() const {
+        return Iterator(m_range.end(), &m_function);
+    }
+
+    Queue<typename std::decay<Result>::type> toQueue() const {
+        return materialize(*this);
+    }
+};
+
+/** Adapters returned by filtered() and transformed(), waiting for a range on the left of operator| */
+template<class PRED>
+struct FilterAdapter {
+    PRED m_predicate;
+};
+
+template<class FUNC>
+struct TransformAdapter {
+    FUNC m_function;
+};
+
+/**
+ * @param: filterFunction - predicate the items have to pass
+ * @return: an adapter that makes a FilteredView of the range it is piped to
+ */
+template<class PRED>
+FilterAdapter<PRED> filtered(PRED filterFunction) {
+    return FilterAdapter<PRED>{std::move(filterFunction)};
+}
+
+/**
+ * @param: transformFunction - function that takes an item and returns the item to yield instead
+ * @return: an adapter that makes a TransformedView of the range it is piped to
+ */
+template<class FUNC>
+TransformAdapter<FUNC> transformed(FUNC transformFunction) {
+    return TransformAdapter<FUNC>{std::move(transformFunction)};
+}
+
+template<class RANGE, class PRED>
+FilteredView<RANGE, PRED> operator|(const RANGE& range, FilterAdapter<PRED> adapter) {
+    return FilteredView<RANGE, PRED>(range, std::move(adapter.m_predicate));
+}
+
+template<class RANGE, class FUNC>
+TransformedView<RANGE, FUNC> operator|(const RANGE& range, TransformAdapter<FUNC> adapter) {
+    return TransformedView<RANGE, FUNC>(range, std::move(adapter.m_function));
+}
+
+#endif // QUEUE_VIEWS_H
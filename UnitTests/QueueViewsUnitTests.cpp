@@ -0,0 +1,92 @@
+#include <string>
+#include "catch.hpp"
+#include "relativeIncludes.h"
+
+TEST_CASE("Queue Views")
+{
+    Queue<int> q;
+    for (int i = 0; i < 1984; i++)
+    {
+        q.pushBack(i);
+    }
+
+    SECTION("Filtered view yields what filter copies")
+    {
+        Queue<int> primesQ = filter(q, isPrime);
+        int count = 0;
+        bool same = true;
+        Queue<int>::Iterator expected = primesQ.begin();
+        for (int prime : q | filtered(isPrime))
+        {
+            same = same && prime == *expected;
+            ++expected;
+            ++count;
+        }
+        REQUIRE(same);
+        REQUIRE(count == 299);
+        REQUIRE(q.size() == 1984);
+    }
+
+    SECTION("Pipelines")
+    {
+        auto squaresOfPrimes = q | filtered(isPrime) | transformed([](int n) { return n * n; });
+        Queue<int> squaresQ = squaresOfPrimes.toQueue();
+        REQUIRE(squaresQ.size() == 299);
+        REQUIRE(squaresQ.front() == 4);
+
+        auto evenHalves = q | transformed([](int n) { return n / 2; }) | filtered([](int n) { return n % 2 == 0; })
+                            | filtered([](int n) { return n < 10; });
+        std::string result;
+        for (int n : evenHalves)
+        {
+            result += std::to_string(n);
+        }
+        REQUIRE(result == "0022446688");
+        REQUIRE(evenHalves.toQueue().size() == 10);
+        REQUIRE((q | filtered([](int n) { return n < 0; })).toQueue().size() == 0);
+    }
+
+    SECTION("Views change nothing and copy nothing")
+    {
+        Queue<DestructionCounter> counters;
+        counters.emplaceBack().emplaceBack().emplaceBack();
+        int before = DestructionCounter::destructed;
+        int seen = 0;
+        for (const DestructionCounter& counter : counters | filtered([](const DestructionCounter&) { return true; }))
+        {
+            (void)counter;
+            ++seen;
+        }
+        REQUIRE(seen == 3);
+        REQUIRE(DestructionCounter::destructed == before);
+    }
+
+    SECTION("Empty queue and types that change")
+    {
+        Queue<int> empty;
+        auto view = empty | filtered(isPrime) | transformed([](int n) { return std::to_string(n); });
+        REQUIRE(view.begin() == view.end());
+
+        Queue<std::string> namesQ = (q | filtered([](int n) { return n > 1981; })
+                                       | transformed([](int n) { return "#" + std::to_string(n); })).toQueue();
+        std::string result;
+        for (const std::string& name : namesQ)
+        {
+            result += name;
+        }
+        REQUIRE(result == "#1982#1983");
+    }
+
+    SECTION("Other queues")
+    {
+        UnrolledQueue<int> unrolled;
+        ArrayQueue<int> array;
+        for (int i = 0; i < 100; i++)
+        {
+            unrolled.pushBack(i);
+            array.pushBack(i);
+        }
+        REQUIRE((unrolled | filtered(isPrime)).toQueue().size() == 25);
+        REQUIRE((array | filtered(isPrime) | transformed([](int n) { return n + 1; })).toQueue().front() == 3);
+    }
+}
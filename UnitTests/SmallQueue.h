@@ -0,0 +1,386 @@
+#ifndef SMALL_QUEUE_H
+#define SMALL_QUEUE_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "Queue.h"
+
+static const int DEFAULT_INLINE_CAPACITY = 8;
+
+/**
+ * @brief: SmallQueue class, a queue that keeps its first items inside the queue object and only spills to nodes
+ *         on the heap when it holds more than that
+ * @tparam T: type of the items in the queue
+ * @tparam InlineCapacity: number of items stored inside the queue object, in a circular buffer
+ * @tparam Alloc: allocator of the Queue the items spill to
+ *
+ * @note: the inline items always come before the spilled ones. Items are pushed inline while nothing is spilled,
+ *        and when an inline item is popped the first spilled item moves into its place, so a queue that shrinks
+ *        back under the inline capacity stops allocating again.
+ * @note: the items are moved into the inline buffer only if their move constructor is noexcept, otherwise the
+ *        spilled items stay on the heap until they are popped
+ */
+template<class T, int InlineCapacity = DEFAULT_INLINE_CAPACITY, class Alloc = std::allocator<T>>
+class SmallQueue {
+    static_assert(InlineCapacity > 0, "SmallQueue needs room for at least one inline item");
+
+public:
+    typedef Queue<T, Alloc> SpillQueue;
+    typedef typename SpillQueue::EmptyQueue EmptyQueue;
+
+private:
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type m_items[InlineCapacity];
+    int m_inlineHead;
+    int m_inlineSize;
+    SpillQueue m_spill;
+
+    /**
+     * @param: index of an inline item, counted from the front of the queue
+     * @return: the slot of the item in the inline buffer, which may not hold an item yet
+     */
+    T* inlineItem(int index) {
+        int position = m_inlineHead + index;
+        return reinterpret_cast<T*>(&m_items[position >= InlineCapacity ? position - InlineCapacity : position]);
+    }
+
+    const T* inlineItem(int index) const {
+        int position = m_inlineHead + index;
+        return reinterpret_cast<const T*>(&m_items[position >= InlineCapacity ? position - InlineCapacity : position]);
+    }
+
+    /**
+     * @description: constructs a new item after the last item, inline if nothing is spilled and there is room
+     * @param: arguments forwarded to the constructor of the item
+     * @note: if the allocation or the construction throws, the queue is left unchanged
+     */
+    template<class... Args>
+    void emplaceItem(Args&&... args) {
+        if (m_spill.size() == EMPTY && m_inlineSize < InlineCapacity) {
+            new (inlineItem(m_inlineSize)) T(std::forward<Args>(args)...);
+            m_inlineSize++;
+        }
+        else {
+            m_spill.emplaceBack(std::forward<Args>(args)...);
+        }
+    }
+
+    /**
+     * @description: moves the inline items of "other" into the empty inline buffer of this queue
+     * @note: items whose move constructor may throw are copied instead, so if that throws the items of "other" are
+     *        unchanged, this queue is left empty and the exception is rethrown
+     */
+    void moveInlineItems(SmallQueue& other) {
+        try {
+            for (; m_inlineSize < other.m_inlineSize; ++m_inlineSize) {
+                new (inlineItem(m_inlineSize)) T(std::move_if_noexcept(*other.inlineItem(m_inlineSize)));
+            }
+        }
+        catch (...) {
+            destroyInlineItems();
+            m_spill = SpillQueue(m_spill.get_allocator());
+            throw;
+        }
+        other.destroyInlineItems();
+    }
+
+    /**
+     * @description: destroys the inline items, leaving the inline buffer empty
+     */
+    void destroyInlineItems() {
+        for (int i = 0; i < m_inlineSize; ++i) {
+            inlineItem(i)->~T();
+        }
+        m_inlineHead = 0;
+        m_inlineSize = 0;
+    }
+
+public:
+    /** Constructor for SmallQueue, nothing is allocated until the inline buffer is full */
+    SmallQueue() : m_inlineHead(0), m_inlineSize(0), m_spill() {}
+
+    /** Constructor for SmallQueue with a given allocator
+     * @param: allocator to allocate the spilled nodes with
+     */
+    explicit SmallQueue(const Alloc& allocator) : m_inlineHead(0), m_inlineSize(0), m_spill(allocator) {}
+
+    /** Copy constructor for SmallQueue
+     * @param: other queue to copy
+     * @note: if a copy or an allocation throws, the items copied so far are destroyed
+     */
+    SmallQueue(const SmallQueue& other) : m_inlineHead(0), m_inlineSize(0), m_spill(other.m_spill) {
+        try {
+            for (; m_inlineSize < other.m_inlineSize; ++m_inlineSize) {
+                new (inlineItem(m_inlineSize)) T(*other.inlineItem(m_inlineSize));
+            }
+        }
+        catch (...) {
+            destroyInlineItems();
+            throw;
+        }
+    }
+
+    /** Move constructor for SmallQueue
+     * @param: other queue, left empty
+     * @note: the inline items are moved one by one, and only once they all moved are the spilled nodes taken over
+     *        in O(1), so if an item throws "other" keeps all of its items
+     */
+    SmallQueue(SmallQueue&& other) noexcept(std::is_nothrow_move_constructible<T>::value) :
+            m_inlineHead(0), m_inlineSize(0), m_spill(other.m_spill.get_allocator()) {
+        moveInlineItems(other);
+        m_spill.swap(other.m_spill);
+    }
+
+    /** Assignment operator for SmallQueue
+     * @param: other queue to copy
+     * @note: the copy is made on the side, so if copying an item or allocating throws the queue is unchanged. The
+     *        copy is then moved in, which cannot throw if the move constructor of T is noexcept; otherwise the items
+     *        are copied in, and if that throws the queue is left empty.
+     */
+    SmallQueue& operator=(const SmallQueue& other) {
+        if (this != &other) {
+            SmallQueue copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    /** Move assignment operator for SmallQueue
+     * @param: other queue, left empty
+     * @note: the inline items are moved before the spilled nodes are taken over, so if an item throws "other" keeps
+     *        all of its items and this queue is left empty
+     */
+    SmallQueue& operator=(SmallQueue&& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        if (this != &other) {
+            destroyInlineItems();
+            moveInlineItems(other);
+            m_spill = std::move(other.m_spill);
+        }
+        return *this;
+    }
+
+    /** Destructor for SmallQueue */
+    ~SmallQueue() {
+        destroyInlineItems();
+    }
+
+    /** swap function
+     * @param: other queue to exchange items with, the inline items are moved and the spilled nodes relinked
+     * @note: noexcept when moving an item is
+     */
+    void swap(SmallQueue& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        SmallQueue moved(std::move(other));
+        other = std::move(*this);
+        *this = std::move(moved);
+    }
+
+    /** pushBack function
+     * @param: item to insert to the queue, it is copied
+     * @return reference to the queue, so we can concatenate functions
+     */
+    SmallQueue& pushBack(const T& toInsert) {
+        emplaceItem(toInsert);
+        return *this;
+    }
+
+    /** pushBack function for temporaries
+     * @param: item to move into the queue
+     * @return reference to the queue, so we can concatenate functions
+     */
+    SmallQueue& pushBack(T&& toInsert) {
+        emplaceItem(std::move(toInsert));
+        return *this;
+    }
+
+    /** emplaceBack function
+     * @param: arguments forwarded to the constructor of the new item
+     * @return reference to the queue, so we can concatenate functions
+     */
+    template<class... Args>
+    SmallQueue& emplaceBack(Args&&... args) {
+        emplaceItem(std::forward<Args>(args)...);
+        return *this;
+    }
+
+    /**
+     * @return reference to first element of the queue
+     */
+    T& front() {
+        if (m_inlineSize != 0) {
+            return *inlineItem(0);
+        }
+        if (m_spill.size() == EMPTY) {
+            throw EmptyQueue();
+        }
+        return m_spill.front();
+    }
+
+    const T& front() const {
+        if (m_inlineSize != 0) {
+            return *inlineItem(0);
+        }
+        if (m_spill.size() == EMPTY) {
+            throw EmptyQueue();
+        }
+        return m_spill.front();
+    }
+
+    /**
+     * @description: removes the first element of the queue
+     * @note: the first spilled item, if any, is moved into the inline slot that was freed
+     */
+    void popFront() {
+        if (m_inlineSize == 0) {
+            if (m_spill.size() == EMPTY) {
+                throw EmptyQueue();
+            }
+            m_spill.popFront();
+            return;
+        }
+        inlineItem(0)->~T();
+        m_inlineHead = (m_inlineHead + 1 == InlineCapacity) ? 0 : m_inlineHead + 1;
+        m_inlineSize--;
+        if (std::is_nothrow_move_constructible<T>::value && m_spill.size() != EMPTY) {
+            new (inlineItem(m_inlineSize)) T(std::move(m_spill.front()));
+            m_inlineSize++;
+            m_spill.popFront();
+        }
+    }
+
+    /**
+     * @param: destination the first element is moved into, before it is removed
+     */
+    void popFront(T& destination) {
+        destination = std::move(front());
+        popFront();
+    }
+
+    /**
+     * @brief: iterator over the items of the queue, the inline items first and then the spilled ones
+     * @tparam IsConst: whether the items may be changed through the iterator
+     */
+    template<bool IsConst>
+    class BasicIterator {
+    private:
+        typedef typename std::conditional<IsConst, const SmallQueue, SmallQueue>::type Container;
+        typedef typename std::conditional<IsConst, typename SpillQueue::ConstIterator,
+                typename SpillQueue::Iterator>::type SpillIterator;
+        typedef typename std::conditional<IsConst, const T, T>::type Item;
+
+        Container* m_queue;
+        int m_index;
+        SpillIterator m_spill;
+
+    public:
+        /**Exception for invalid operation*/
+        class InvalidOperation {};
+
+        BasicIterator(Container* queue, int index, SpillIterator spill) :
+                m_queue(queue), m_index(index), m_spill(spill) {}
+
+        Item& operator*() const {
+            if (m_index < m_queue->m_inlineSize) {
+                return *m_queue->inlineItem(m_index);
+            }
+            if (m_spill == m_queue->m_spill.end()) {
+                throw InvalidOperation();
+            }
+            // The item lives in its node, so a copy of the spill iterator reaches the same one
+            SpillIterator spill = m_spill;
+            return *spill;
+        }
+
+        BasicIterator& operator++() {
+            if (m_index < m_queue->m_inlineSize) {
+                ++m_index;
+            }
+            else if (m_spill == m_queue->m_spill.end()) {
+                throw InvalidOperation();
+            }
+            else {
+                ++m_spill;
+            }
+            return *this;
+        }
+
+        bool operator==(const BasicIterator& other) const {
+            return m_index == other.m_index && m_spill == other.m_spill;
+        }
+
+        bool operator!=(const BasicIterator& other) const {
+            return !(*this == other);
+        }
+    };
+
+    typedef BasicIterator<false> Iterator;
+    typedef BasicIterator<true> ConstIterator;
+
+    Iterator begin() {
+        return Iterator(this, 0, m_spill.begin());
+    }
+
+    Iterator end() {
+        return Iterator(this, m_inlineSize, m_spill.end());
+    }
+
+    ConstIterator begin() const {
+        return ConstIterator(this, 0, m_spill.begin());
+    }
+
+    ConstIterator end() const {
+        return ConstIterator(this, m_inlineSize, m_spill.end());
+    }
+
+    /**
+     * @return true if none of the items is stored on the heap
+     */
+    bool isInline() const {
+        return m_spill.size() == EMPTY;
+    }
+
+    /**
+     * @return copy of the allocator of the spilled nodes
+     */
+    Alloc get_allocator() const {
+        return m_spill.get_allocator();
+    }
+
+    /**
+     * @return number of elements in the queue
+     */
+    std::size_t size() const {
+        return static_cast<std::size_t>(m_inlineSize) + m_spill.size();
+    }
+};
+
+template<typename T, int InlineCapacity, class Alloc, typename FUNC>
+SmallQueue<T, InlineCapacity, Alloc> filter(const SmallQueue<T, InlineCapacity, Alloc>& queueToFilter,
+                                            FUNC filterFunction) {
+    typedef SmallQueue<T, InlineCapacity, Alloc> FilteredQueue;
+    FilteredQueue newFilteredQueue(queueToFilter.get_allocator());
+    for (typename FilteredQueue::ConstIterator i = queueToFilter.begin(); i != queueToFilter.end(); ++i) {
+        if (filterFunction(*i) == true) {
+            newFilteredQueue.pushBack(*i);
+        }
+    }
+    return newFilteredQueue;
+}
+
+template<class T, int InlineCapacity, class Alloc>
+void swap(SmallQueue<T, InlineCapacity, Alloc>& first, SmallQueue<T, InlineCapacity, Alloc>& second)
+        noexcept(noexcept(first.swap(second))) {
+    first.swap(second);
+}
+
+template<typename T, int InlineCapacity, class Alloc, typename FUNC>
+void transform(SmallQueue<T, InlineCapacity, Alloc>& queueToTransform, FUNC transformFunction) {
+    typedef SmallQueue<T, InlineCapacity, Alloc> TransformedQueue;
+    for (typename TransformedQueue::Iterator i = queueToTransform.begin(); i != queueToTransform.end(); ++i) {
+        T& itemReference = *i;
+        transformFunction(itemReference);
+    }
+}
+
+#endif // SMALL_QUEUE_H
@@ -0,0 +1,193 @@
+#include <string>
+#include <utility>
+#include "catch.hpp"
+#include "relativeIncludes.h"
+
+// Small inline buffers, so that the tests spill all the time
+typedef SmallQueue<int, 4> SmallIntQueue;
+typedef SmallQueue<ControlledAllocer, 2> SmallControlledQueue;
+
+template <class T, int InlineCapacity>
+std::string readSmallQueue(const SmallQueue<T, InlineCapacity>& q)
+{
+    std::string result;
+    for (const T& item : q)
+    {
+        result += std::to_string(item) + " ";
+    }
+    return result;
+}
+
+// Inline buffers the scenario spills out of all the time, and the default inline capacity
+TEMPLATE_TEST_CASE("SmallQueue int Queue", "[basics]", (SmallQueue<int, 1>), (SmallQueue<int, 4>), SmallQueue<int>)
+{
+    checkIntQueueScenario<TestType>();
+}
+
+TEST_CASE("SmallQueue")
+{
+    SECTION("Items stay inline")
+    {
+        SmallQueue<int> q;
+        for (int i = 0; i < DEFAULT_INLINE_CAPACITY; i++)
+        {
+            q.pushBack(i);
+        }
+        REQUIRE(q.isInline());
+        q.pushBack(8);
+        q.pushBack(9);
+        REQUIRE(!q.isInline());
+        REQUIRE(readSmallQueue(q) == "0 1 2 3 4 5 6 7 8 9 ");
+
+        // Popping inline items moves the spilled ones back in
+        q.popFront();
+        REQUIRE(!q.isInline());
+        q.popFront();
+        REQUIRE(q.isInline());
+        REQUIRE(readSmallQueue(q) == "2 3 4 5 6 7 8 9 ");
+
+        // A queue that stays under the inline capacity wraps around its buffer and never spills
+        for (int i = 10; i < 1000; i++)
+        {
+            q.popFront();
+            q.pushBack(i);
+            REQUIRE(q.isInline());
+        }
+        REQUIRE(readSmallQueue(q) == "992 993 994 995 996 997 998 999 ");
+    }
+
+    SECTION("Copies and moves")
+    {
+        SmallIntQueue spilled;
+        for (int i = 0; i < 6; i++)
+        {
+            spilled.pushBack(i);
+        }
+        SmallIntQueue small;
+        small.pushBack(100);
+
+        SmallIntQueue copy(spilled);
+        copy.front() = 42;
+        REQUIRE(readSmallQueue(copy) == "42 1 2 3 4 5 ");
+        REQUIRE(readSmallQueue(spilled) == "0 1 2 3 4 5 ");
+
+        copy = small;
+        REQUIRE(readSmallQueue(copy) == "100 ");
+        copy = spilled;
+        REQUIRE(readSmallQueue(copy) == "0 1 2 3 4 5 ");
+        copy = copy;
+        REQUIRE(copy.size() == 6);
+
+        SmallIntQueue moved(std::move(copy));
+        REQUIRE(readSmallQueue(moved) == "0 1 2 3 4 5 ");
+        REQUIRE(copy.size() == 0);
+        REQUIRE(copy.isInline());
+        copy.pushBack(7);
+        REQUIRE(copy.front() == 7);
+
+        moved = std::move(small);
+        REQUIRE(readSmallQueue(moved) == "100 ");
+        REQUIRE(small.size() == 0);
+
+        swap(moved, spilled);
+        REQUIRE(readSmallQueue(moved) == "0 1 2 3 4 5 ");
+        REQUIRE(readSmallQueue(spilled) == "100 ");
+        REQUIRE(noexcept(swap(moved, spilled)));
+        REQUIRE_FALSE(noexcept(swap(std::declval<SmallControlledQueue&>(), std::declval<SmallControlledQueue&>())));
+
+        // const iterators dereference an inline item and a spilled one
+        const SmallIntQueue::Iterator first = moved.begin();
+        *first = 9;
+        SmallIntQueue::Iterator spilledItem = moved.begin();
+        for (int i = 0; i < 5; i++)
+        {
+            ++spilledItem;
+        }
+        const SmallIntQueue::Iterator last = spilledItem;
+        *last = 50;
+        REQUIRE(readSmallQueue(moved) == "9 1 2 3 4 50 ");
+    }
+
+    SECTION("Items are destroyed once")
+    {
+        DestructionCounter::destructed = 0;
+        {
+            SmallQueue<DestructionCounter, 3> q;
+            for (int i = 0; i < 10; i++)
+            {
+                q.emplaceBack(i);
+            }
+            int temporaries = DestructionCounter::destructed;
+            q.popFront();
+            q.popFront();
+            REQUIRE(q.front().someInteger == 2);
+            // Every pop destroys the popped item, and the moved-from node of the item that moved inline
+            REQUIRE(DestructionCounter::destructed == temporaries + 4);
+
+            SmallQueue<DestructionCounter, 3> copy(q);
+            REQUIRE(copy.size() == 8);
+            DestructionCounter::destructed = 0;
+        }
+        REQUIRE(DestructionCounter::destructed == 16);
+    }
+
+    SECTION("Failed copies leave the queues unchanged")
+    {
+        ControlledAllocer::allowedAllocs = 10;
+        ControlledAllocer c;
+        SmallControlledQueue q;
+        for (int i = 0; i < 4; i++)
+        {
+            q.pushBack(c);
+        }
+        q.front().someInteger = 666;
+
+        SmallControlledQueue target;
+        target.pushBack(c);
+        target.front().someInteger = 42;
+
+        // Two spilled items copy, then the first inline copy fails
+        ControlledAllocer::allowedAllocs = 2;
+        REQUIRE_THROWS_AS(target = q, std::bad_alloc);
+        REQUIRE(target.size() == 1);
+        REQUIRE(target.front().someInteger == 42);
+        REQUIRE_THROWS_AS(SmallControlledQueue(q), std::bad_alloc);
+        REQUIRE(q.size() == 4);
+        REQUIRE(q.front().someInteger == 666);
+
+        // ControlledAllocer has no noexcept move, so moving copies the inline items before any node is taken
+        ControlledAllocer::allowedAllocs = 1;
+        REQUIRE_THROWS_AS(SmallControlledQueue(std::move(q)), std::bad_alloc);
+        REQUIRE(q.size() == 4);
+        REQUIRE(q.front().someInteger == 666);
+
+        ControlledAllocer::allowedAllocs = 1;
+        REQUIRE_THROWS_AS(target = std::move(q), std::bad_alloc);
+        REQUIRE(q.size() == 4);
+        REQUIRE(q.front().someInteger == 666);
+        REQUIRE(target.size() == 0);
+
+        ControlledAllocer::allowedAllocs = 2;
+        target = std::move(q);
+        REQUIRE(target.size() == 4);
+        REQUIRE(q.size() == 0);
+    }
+
+    SECTION("Strings")
+    {
+        SmallQueue<std::string, 2> q;
+        q.pushBack("first").pushBack("second").pushBack(std::string("third"));
+        q.emplaceBack(3, 'x');
+        REQUIRE(q.size() == 4);
+
+        std::string destination;
+        q.popFront(destination);
+        REQUIRE(destination == "first");
+        q.popFront(destination);
+        REQUIRE(destination == "second");
+        REQUIRE(q.isInline());
+        REQUIRE(q.front() == "third");
+        q.popFront();
+        REQUIRE(q.front() == "xxx");
+    }
+}
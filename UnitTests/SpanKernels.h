@@ -0,0 +1,366 @@
+#ifndef SPAN_KERNELS_H
+#define SPAN_KERNELS_H
+
+#include <cstddef>
+#include <type_traits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SPAN_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief: the loops of filter and transform over a run of items that are contiguous in memory
+ *
+ * @note: the queues that store their items in arrays hand their runs to these kernels as plain pointers, so the
+ *        loops have no iterator checks in them. The loops are scalar, except for filters by a CompareTo predicate
+ *        on int or float items, which compare and compact a whole vector of items at a time with AVX-512 or AVX2,
+ *        whichever the CPU running the program supports.
+ */
+
+static const int COMPACTION_BUFFER_SIZE = 256;
+
+/** The comparisons a CompareTo predicate can make */
+enum Comparison {
+    COMPARE_LESS,
+    COMPARE_GREATER,
+    COMPARE_EQUAL
+};
+
+/**
+ * @brief: CompareTo, a predicate that compares every item to a bound, as in "item < bound" for COMPARE_LESS
+ * @tparam T: type of the items
+ * @tparam Op: the comparison
+ *
+ * @note: filter recognizes it, so use lessThan(bound) rather than an equivalent lambda where the items are int or
+ *        float to get the vector kernels
+ */
+template<class T, Comparison Op>
+struct CompareTo {
+    T m_bound;
+
+    bool operator()(const T& item) const {
+        if (Op == COMPARE_LESS) {
+            return item < m_bound;
+        }
+        if (Op == COMPARE_GREATER) {
+            return m_bound < item;
+        }
+        return item == m_bound;
+    }
+};
+
+template<class T>
+CompareTo<T, COMPARE_LESS> lessThan(T bound) {
+    return CompareTo<T, COMPARE_LESS>{bound};
+}
+
+template<class T>
+CompareTo<T, COMPARE_GREATER> greaterThan(T bound) {
+    return CompareTo<T, COMPARE_GREATER>{bound};
+}
+
+template<class T>
+CompareTo<T, COMPARE_EQUAL> equalTo(T bound) {
+    return CompareTo<T, COMPARE_EQUAL>{bound};
+}
+
+/**
+ * @description: applies the function to every item of the run, in order
+ * @param: first, last - the run of items
+ */
+template<class T, class FUNC>
+void transformSpan(T* first, T* last, FUNC& transformFunction) {
+    for (; first != last; ++first) {
+        transformFunction(*first);
+    }
+}
+
+/**
+ * @description: copies the items of the run that pass the filter to "out", in order
+ * @param: out - room for as many items as the run holds
+ * @return: number of items copied
+ *
+ * @explain: Every item is written to the next free slot, and the slot only advances if it passed, so the loop has
+ *           no branch on the predicate to mispredict.
+ */
+template<class T, class PRED>
+std::size_t compactSpanScalar(const T* first, const T* last, PRED& filterFunction, T* out) {
+    std::size_t count = 0;
+    for (; first != last; ++first) {
+        out[count] = *first;
+        count += (filterFunction(*first) == true) ? 1 : 0;
+    }
+    return count;
+}
+
+#ifdef SPAN_KERNELS_X86
+
+/**
+ * @brief: the instruction sets of the CPU running the program, detected once
+ */
+struct CpuFeatures {
+    bool m_avx2;
+    bool m_avx512;
+
+    CpuFeatures() {
+        __builtin_cpu_init();
+        m_avx2 = __builtin_cpu_supports("avx2") != 0;
+        m_avx512 = __builtin_cpu_supports("avx512f") != 0;
+    }
+};
+
+inline const CpuFeatures& cpuFeatures() {
+    static const CpuFeatures features;
+    return features;
+}
+
+/**
+ * @brief: for every 8 bit mask, the lanes whose bit is set in the order they are packed to the front of a vector
+ */
+struct CompactionShuffles {
+    unsigned char m_lanes[256][8];
+
+    CompactionShuffles() {
+        for (int mask = 0; mask < 256; ++mask) {
+            int count = 0;
+            for (int lane = 0; lane < 8; ++lane) {
+                if ((mask & (1 << lane)) != 0) {
+                    m_lanes[mask][count++] = static_cast<unsigned char>(lane);
+                }
+            }
+            for (; count < 8; ++count) {
+                m_lanes[mask][count] = 0;
+            }
+        }
+    }
+};
+
+inline const CompactionShuffles& compactionShuffles() {
+    static const CompactionShuffles shuffles;
+    return shuffles;
+}
+
+/** Runs of other types, and CPUs without the instructions, use the scalar kernel */
+template<class T, Comparison Op>
+std::size_t compactSpanAvx2(const T* first, const T* last, const CompareTo<T, Op>& filterFunction, T* out) {
+    return compactSpanScalar(first, last, filterFunction, out);
+}
+
+template<class T, Comparison Op>
+std::size_t compactSpanAvx512(const T* first, const T* last, const CompareTo<T, Op>& filterFunction, T* out) {
+    return compactSpanScalar(first, last, filterFunction, out);
+}
+
+/**
+ * @description: compactSpanScalar for CompareTo on ints, 8 items at a time
+ * @explain: The comparison gives a mask of the passing lanes, which picks from a table the permutation that packs
+ *           them to the front. The whole vector is stored at the next free slot and the slot advances by the number
+ *           of passing lanes, so the lanes that did not pass are overwritten by the next store.
+ * @note: the caller has to check cpuFeatures().m_avx2 first
+ */
+template<Comparison Op>
+__attribute__((target("avx2")))
+std::size_t compactSpanAvx2(const int* first, const int* last, const CompareTo<int, Op>& filterFunction, int* out) {
+    const CompactionShuffles& shuffles = compactionShuffles();
+    const __m256i bound = _mm256_set1_epi32(filterFunction.m_bound);
+    std::size_t count = 0;
+    for (; last - first >= 8; first += 8) {
+        __m256i items = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+        __m256i passed;
+        if (Op == COMPARE_LESS) {
+            passed = _mm256_cmpgt_epi32(bound, items);
+        }
+        else if (Op == COMPARE_GREATER) {
+            passed = _mm256_cmpgt_epi32(items, bound);
+        }
+        else {
+            passed = _mm256_cmpeq_epi32(items, bound);
+        }
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(passed));
+        __m256i lanes = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(shuffles.m_lanes[mask])));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + count), _mm256_permutevar8x32_epi32(items, lanes));
+        count += static_cast<std::size_t>(__builtin_popcount(mask));
+    }
+    return count + compactSpanScalar(first, last, filterFunction, out + count);
+}
+
+/**
+ * @description: compactSpanScalar for CompareTo on floats, 8 items at a time, as for ints
+ * @note: the comparisons are ordered, so a NaN never passes, as with the scalar operators
+ */
+template<Comparison Op>
+__attribute__((target("avx2")))
+std::size_t compactSpanAvx2(const float* first, const float* last, const CompareTo<float, Op>& filterFunction,
+                            float* out) {
+    const CompactionShuffles& shuffles = compactionShuffles();
+    const __m256 bound = _mm256_set1_ps(filterFunction.m_bound);
+    std::size_t count = 0;
+    for (; last - first >= 8; first += 8) {
+        __m256 items = _mm256_loadu_ps(first);
+        __m256 passed;
+        if (Op == COMPARE_LESS) {
+            passed = _mm256_cmp_ps(items, bound, _CMP_LT_OQ);
+        }
+        else if (Op == COMPARE_GREATER) {
+            passed = _mm256_cmp_ps(items, bound, _CMP_GT_OQ);
+        }
+        else {
+            passed = _mm256_cmp_ps(items, bound, _CMP_EQ_OQ);
+        }
+        int mask = _mm256_movemask_ps(passed);
+        __m256i lanes = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(shuffles.m_lanes[mask])));
+        _mm256_storeu_ps(out + count, _mm256_permutevar8x32_ps(items, lanes));
+        count += static_cast<std::size_t>(__builtin_popcount(mask));
+    }
+    return count + compactSpanScalar(first, last, filterFunction, out + count);
+}
+
+/**
+ * @description: compactSpanScalar for CompareTo on ints, 16 items at a time, packed by the compress instruction
+ * @note: the caller has to check cpuFeatures().m_avx512 first
+ */
+template<Comparison Op>
+__attribute__((target("avx512f")))
+std::size_t compactSpanAvx512(const int* first, const int* last, const CompareTo<int, Op>& filterFunction, int* out) {
+    const __m512i bound = _mm512_set1_epi32(filterFunction.m_bound);
+    std::size_t count = 0;
+    for (; last - first >= 16; first += 16) {
+        __m512i items = _mm512_loadu_si512(first);
+        __mmask16 passed;
+        if (Op == COMPARE_LESS) {
+            passed = _mm512_cmplt_epi32_mask(items, bound);
+        }
+        else if (Op == COMPARE_GREATER) {
+            passed = _mm512_cmpgt_epi32_mask(items, bound);
+        }
+        else {
+            passed = _mm512_cmpeq_epi32_mask(items, bound);
+        }
+        _mm512_storeu_si512(out + count, _mm512_maskz_compress_epi32(passed, items));
+        count += static_cast<std::size_t>(__builtin_popcount(passed));
+    }
+    return count + compactSpanScalar(first, last, filterFunction, out + count);
+}
+
+template<Comparison Op>
+__attribute__((target("avx512f")))
+std::size_t compactSpanAvx512(const float* first, const float* last, const CompareTo<float, Op>& filterFunction,
+                              float* out) {
+    const __m512 bound = _mm512_set1_ps(filterFunction.m_bound);
+    std::size_t count = 0;
+    for (; last - first >= 16; first += 16) {
+        __m512 items = _mm512_loadu_ps(first);
+        __mmask16 passed;
+        if (Op == COMPARE_LESS) {
+            passed = _mm512_cmp_ps_mask(items, bound, _CMP_LT_OQ);
+        }
+        else if (Op == COMPARE_GREATER) {
+            passed = _mm512_cmp_ps_mask(items, bound, _CMP_GT_OQ);
+        }
+        else {
+            passed = _mm512_cmp_ps_mask(items, bound, _CMP_EQ_OQ);
+        }
+        _mm512_storeu_ps(out + count, _mm512_maskz_compress_ps(passed, items));
+        count += static_cast<std::size_t>(__builtin_popcount(passed));
+    }
+    return count + compactSpanScalar(first, last, filterFunction, out + count);
+}
+
+#endif // SPAN_KERNELS_X86
+
+/**
+ * @description: copies the items of the run that pass the filter to "out", in order
+ * @return: number of items copied
+ */
+template<class T, class PRED>
+std::size_t compactSpan(const T* first, const T* last, PRED& filterFunction, T* out) {
+    return compactSpanScalar(first, last, filterFunction, out);
+}
+
+/**
+ * @description: compactSpan for a CompareTo predicate, with the widest vector kernel the CPU supports
+ */
+template<class T, Comparison Op>
+std::size_t compactSpan(const T* first, const T* last, CompareTo<T, Op>& filterFunction, T* out) {
+#ifdef SPAN_KERNELS_X86
+    const CpuFeatures& features = cpuFeatures();
+    if (features.m_avx512) {
+        return compactSpanAvx512(first, last, filterFunction, out);
+    }
+    if (features.m_avx2) {
+        return compactSpanAvx2(first, last, filterFunction, out);
+    }
+#endif
+    return compactSpanScalar(first, last, filterFunction, out);
+}
+
+/**
+ * @description: pushes the items of the run that pass the filter to the back of the destination, for any type
+ */
+template<class T, class PRED, class QUEUE>
+void filterSpan(const T* first, const T* last, PRED& filterFunction, QUEUE& destination, std::false_type) {
+    for (; first != last; ++first) {
+        if (filterFunction(*first) == true) {
+            destination.pushBack(*first);
+        }
+    }
+}
+
+/**
+ * @description: pushes the items of the run that pass the filter to the back of the destination, for arithmetic types
+ * @explain: The items are compacted into a buffer, a chunk at a time, and the buffer is then pushed in a loop with
+ *           no branch on the predicate.
+ */
+template<class T, class PRED, class QUEUE>
+void filterSpan(const T* first, const T* last, PRED& filterFunction, QUEUE& destination, std::true_type) {
+    T buffer[COMPACTION_BUFFER_SIZE];
+    while (first != last) {
+        const T* chunkEnd = (last - first > COMPACTION_BUFFER_SIZE) ? first + COMPACTION_BUFFER_SIZE : last;
+        std::size_t count = compactSpan(first, chunkEnd, filterFunction, buffer);
+        first = chunkEnd;
+        for (std::size_t i = 0; i < count; ++i) {
+            destination.pushBack(buffer[i]);
+        }
+    }
+}
+
+/**
+ * @description: pushes the items of the run that pass the filter to the back of the destination, in order
+ * @param: first, last - the run of items
+ * @param: filterFunction - called once on every item
+ */
+template<class T, class PRED, class QUEUE>
+void filterSpan(const T* first, const T* last, PRED& filterFunction, QUEUE& destination) {
+    filterSpan(first, last, filterFunction, destination, std::is_arithmetic<T>());
+}
+
+/**
+ * @brief: TransformKernel, transformSpan over every run the queue hands it
+ * @note: the function is held by value, so a function pointer stays a constant the compiler can inline
+ */
+template<class FUNC>
+struct TransformKernel {
+    FUNC m_function;
+
+    template<class T>
+    void operator()(T* first, T* last) {
+        transformSpan(first, last, m_function);
+    }
+};
+
+/**
+ * @brief: FilterKernel, filterSpan over every run the queue hands it, into the destination queue
+ */
+template<class PRED, class QUEUE>
+struct FilterKernel {
+    PRED m_predicate;
+    QUEUE* m_destination;
+
+    template<class T>
+    void operator()(const T* first, const T* last) {
+        filterSpan(first, last, m_predicate, *m_destination);
+    }
+};
+
+#endif // SPAN_KERNELS_H
@@ -0,0 +1,201 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <thread>
+#include <utility>
+#include "CacheLine.h"
+
+/**
+ * @brief: SpscQueue class, a bounded lock-free queue for exactly one producer thread and one consumer thread
+ * @tparam T: type of the items in the queue
+ *
+ * @note: pushBack/tryPushBack may only be called by the producer, front/popFront/tryPopFront only by the consumer
+ * @note: the producer publishes the tail index with release semantics and the consumer the head index, each side
+ *        keeps a cached copy of the other's index, and the two indices live on separate cache lines
+ */
+template<class T>
+class SpscQueue {
+private:
+    // Written by the consumer
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_head;
+    std::size_t m_cachedTail;
+
+    // Written by the producer
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_tail;
+    std::size_t m_cachedHead;
+
+    // Never written after construction
+    alignas(CACHE_LINE_SIZE) T* m_items;
+    std::size_t m_mask;
+
+    static std::size_t roundUpToPowerOfTwo(std::size_t capacity) {
+        std::size_t rounded = 1;
+        while (rounded < capacity) {
+            rounded *= 2;
+        }
+        return rounded;
+    }
+
+    /**
+     * @description: constructs a new item after the last item, if there is room for it
+     * @note: producer only
+     * @return: false if the queue was full
+     */
+    template<class... Args>
+    bool emplaceItem(Args&&... args) {
+        std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cachedHead > m_mask) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead > m_mask) {
+                return false;
+            }
+        }
+        new (m_items + (tail & m_mask)) T(std::forward<Args>(args)...);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @note: consumer only
+     * @return: pointer to the first item, or nullptr if the queue is empty
+     */
+    T* frontItem() {
+        std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_cachedTail) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cachedTail) {
+                return nullptr;
+            }
+        }
+        return m_items + (head & m_mask);
+    }
+
+    /**
+     * @description: destroys the first item and hands its slot back to the producer
+     * @note: consumer only, the queue must not be empty
+     */
+    void removeFront() {
+        std::size_t head = m_head.load(std::memory_order_relaxed);
+        m_items[head & m_mask].~T();
+        m_head.store(head + 1, std::memory_order_release);
+    }
+
+public:
+    /** Exceptions*/
+    class EmptyQueue {};
+
+    /** Constructor for SpscQueue
+     * @param: capacity - the least number of items the queue can hold, rounded up to a power of two
+     */
+    explicit SpscQueue(std::size_t capacity) : m_head(0), m_cachedTail(0), m_tail(0), m_cachedHead(0),
+            m_items(static_cast<T*>(::operator new(sizeof(T) * roundUpToPowerOfTwo(capacity)))),
+            m_mask(roundUpToPowerOfTwo(capacity) - 1) {}
+
+    /** The queue is shared by two threads through its address, so it is never copied or moved */
+    SpscQueue(const SpscQueue& other) = delete;
+    SpscQueue& operator=(const SpscQueue& other) = delete;
+
+    /** Destructor for SpscQueue, must not run while one of the threads still uses the queue */
+    ~SpscQueue() {
+        std::size_t tail = m_tail.load(std::memory_order_acquire);
+        for (std::size_t i = m_head.load(std::memory_order_acquire); i != tail; ++i) {
+            m_items[i & m_mask].~T();
+        }
+        ::operator delete(m_items);
+    }
+
+    /** tryPushBack function
+     * @param: arguments forwarded to the constructor of the new item
+     * @note: producer only
+     *
+     * @return true if the item was inserted, false if the queue was full
+     */
+    template<class... Args>
+    bool tryPushBack(Args&&... args) {
+        return emplaceItem(std::forward<Args>(args)...);
+    }
+
+    /** pushBack function
+     * @param: item to insert to the queue, it is copied
+     * @note: producer only, yields until the consumer makes room when the queue is full
+     *
+     * @return reference to the queue, so we can concatenate functions
+     */
+    SpscQueue& pushBack(const T& toInsert) {
+        while (!emplaceItem(toInsert)) {
+            std::this_thread::yield();
+        }
+        return *this;
+    }
+
+    /** pushBack function for temporaries
+     * @param: item to move into the queue
+     * @note: producer only, yields until the consumer makes room when the queue is full
+     */
+    SpscQueue& pushBack(T&& toInsert) {
+        while (!emplaceItem(std::move(toInsert))) {
+            std::this_thread::yield();
+        }
+        return *this;
+    }
+
+    /** front function
+     * @note: consumer only
+     *
+     * @return reference to first element of the queue
+     */
+    T& front() {
+        T* item = frontItem();
+        if (item == nullptr) {
+            throw EmptyQueue();
+        }
+        return *item;
+    }
+
+    /**
+     * @description: removes the first element of the queue
+     * @note: consumer only
+     */
+    void popFront() {
+        if (frontItem() == nullptr) {
+            throw EmptyQueue();
+        }
+        removeFront();
+    }
+
+    /**
+     * @param: destination the first element is moved into
+     * @note: consumer only
+     *
+     * @return true if an element was moved out, false if the queue was empty
+     */
+    bool tryPopFront(T& destination) {
+        T* item = frontItem();
+        if (item == nullptr) {
+            return false;
+        }
+        destination = std::move(*item);
+        removeFront();
+        return true;
+    }
+
+    /**
+     * @return number of elements in the queue, only a snapshot when the other thread is active
+     */
+    std::size_t size() const {
+        std::size_t head = m_head.load(std::memory_order_acquire);
+        return m_tail.load(std::memory_order_acquire) - head;
+    }
+
+    /**
+     * @return number of elements the queue can hold
+     */
+    std::size_t capacity() const {
+        return m_mask + 1;
+    }
+};
+
+#endif // SPSC_QUEUE_H
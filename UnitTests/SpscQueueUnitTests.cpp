@@ -0,0 +1,94 @@
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include "catch.hpp"
+#include "relativeIncludes.h"
+
+TEST_CASE("SpscQueue Basics")
+{
+    SECTION("Single thread")
+    {
+        SpscQueue<int> q(5);
+        REQUIRE(q.capacity() == 8);
+        REQUIRE(q.size() == 0);
+        REQUIRE_THROWS_AS(q.front(), SpscQueue<int>::EmptyQueue);
+        REQUIRE_THROWS_AS(q.popFront(), SpscQueue<int>::EmptyQueue);
+
+        for (int i = 0; i < 8; ++i)
+        {
+            REQUIRE(q.tryPushBack(i));
+        }
+        REQUIRE_FALSE(q.tryPushBack(8));
+        REQUIRE(q.size() == 8);
+
+        REQUIRE(q.front() == 0);
+        q.front() = 10;
+        REQUIRE(q.front() == 10);
+        q.popFront();
+        REQUIRE(q.tryPushBack(8));
+
+        int out = 0;
+        for (int i = 1; i <= 8; ++i)
+        {
+            REQUIRE(q.tryPopFront(out));
+            REQUIRE(out == i);
+        }
+        REQUIRE_FALSE(q.tryPopFront(out));
+        REQUIRE(out == 8);
+        REQUIRE(q.size() == 0);
+    }
+
+    SECTION("The indices live on their own cache lines")
+    {
+        SpscQueue<int> first(4), second(4);
+        REQUIRE(alignof(SpscQueue<int>) == CACHE_LINE_SIZE);
+        REQUIRE(sizeof(SpscQueue<int>) == 3 * CACHE_LINE_SIZE);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(&second) % CACHE_LINE_SIZE == 0);
+        REQUIRE(alignof(ConcurrentQueue<int>) == CACHE_LINE_SIZE);
+        REQUIRE(alignof(WorkStealingDeque<int>) == CACHE_LINE_SIZE);
+    }
+
+    SECTION("Items left in the queue are destroyed")
+    {
+        std::shared_ptr<int> item(new int(1));
+        {
+            SpscQueue<std::shared_ptr<int>> q(4);
+            q.pushBack(item).pushBack(item);
+            q.popFront();
+            q.pushBack(item);
+            REQUIRE(item.use_count() == 3);
+        }
+        REQUIRE(item.use_count() == 1);
+    }
+
+    SECTION("One producer and one consumer")
+    {
+        const int itemsCount = 100000;
+        SpscQueue<int> q(64);
+        std::thread producer([&q, itemsCount]()
+        {
+            for (int i = 0; i < itemsCount; ++i)
+            {
+                q.pushBack(i);
+            }
+        });
+
+        bool inOrder = true;
+        int out = 0;
+        for (int expected = 0; expected < itemsCount; )
+        {
+            if (q.tryPopFront(out))
+            {
+                inOrder = inOrder && (out == expected);
+                ++expected;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+        producer.join();
+        REQUIRE(inOrder);
+        REQUIRE(q.size() == 0);
+    }
+}
@@ -0,0 +1,249 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "CacheLine.h"
+#include "Queue.h"
+#include "WorkStealingDeque.h"
+
+/**
+ * @brief: ThreadPool class, a work-stealing task scheduler
+ *
+ * @note: every worker owns a WorkStealingDeque. Tasks submitted by a worker go to the bottom of its own deque,
+ *        tasks submitted from outside go to a global injection Queue. A worker runs its own newest task first,
+ *        then the injected tasks, and only when both are empty steals the oldest task of another worker.
+ * @note: idle workers sleep until a task is submitted, so the shared mutex is only taken on the slow paths
+ * @note: tasks must not throw
+ */
+class ThreadPool {
+private:
+    typedef std::function<void()> Task;
+
+    /** Allocated one by one, aligned so that the indices of the deque stay on their own cache lines */
+    struct Worker : CacheLineAligned {
+        WorkStealingDeque<Task*> m_deque;
+        std::thread m_thread;
+    };
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    Queue<Task*> m_injected;
+    std::atomic<int> m_injectedCount;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeUp;
+    std::atomic<int> m_queuedTasks;
+    std::atomic<int> m_sleepers;
+    std::atomic<bool> m_stopping;
+
+    /** Index of the worker running on the calling thread, in the pool it belongs to */
+    struct WorkerIdentity {
+        ThreadPool* m_pool;
+        int m_index;
+    };
+
+    static WorkerIdentity& currentWorker() {
+        static thread_local WorkerIdentity identity = {nullptr, -1};
+        return identity;
+    }
+
+    /**
+     * @description: counts a queued task and wakes a sleeping worker, if there is one
+     */
+    void announceTask() {
+        m_queuedTasks.fetch_add(1);
+        if (m_sleepers.load() > 0) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_wakeUp.notify_one();
+        }
+    }
+
+    /**
+     * @description: takes a task, from the deque of the worker, then from the injection queue, then by stealing
+     * @param: index - of the calling worker, or -1 for a thread outside the pool
+     * @return: the task, or nullptr if none was found
+     */
+    Task* findTask(int index) {
+        Task* task = nullptr;
+        if (index >= 0 && m_workers[index]->m_deque.popBottom(task)) {
+            m_queuedTasks.fetch_sub(1);
+            return task;
+        }
+        if (m_injectedCount.load() > 0) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_injected.size() != EMPTY) {
+                m_injected.popFront(task);
+                m_injectedCount.fetch_sub(1);
+                m_queuedTasks.fetch_sub(1);
+                return task;
+            }
+        }
+        int workersCount = static_cast<int>(m_workers.size());
+        for (int i = 1; i <= workersCount; ++i) {
+            int victim = (index + i + workersCount) % workersCount;
+            if (victim != index && m_workers[victim]->m_deque.steal(task)) {
+                m_queuedTasks.fetch_sub(1);
+                return task;
+            }
+        }
+        return nullptr;
+    }
+
+    static void run(Task* task) {
+        std::unique_ptr<Task> owner(task);
+        (*owner)();
+    }
+
+    void workerLoop(int index) {
+        currentWorker().m_pool = this;
+        currentWorker().m_index = index;
+        while (true) {
+            Task* task = findTask(index);
+            if (task != nullptr) {
+                run(task);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_sleepers.fetch_add(1);
+            m_wakeUp.wait(lock, [this]() { return m_queuedTasks.load() > 0 || m_stopping.load(); });
+            m_sleepers.fetch_sub(1);
+            if (m_stopping.load() && m_queuedTasks.load() == 0) {
+                return;
+            }
+        }
+    }
+
+    /**
+     * @description: runs the tasks of a range, splitting off its upper half as a new task while it is too long
+     */
+    static void splitRange(ThreadPool& pool, int begin, int end, int grain, const std::function<void(int, int)>& body,
+                           const std::shared_ptr<std::atomic<int>>& pending) {
+        while (end - begin > grain) {
+            int middle = begin + (end - begin) / 2;
+            pending->fetch_add(1);
+            pool.submit([&pool, middle, end, grain, &body, pending]() {
+                splitRange(pool, middle, end, grain, body, pending);
+            });
+            end = middle;
+        }
+        body(begin, end);
+        pending->fetch_sub(1);
+    }
+
+    /**
+     * @description: tells the workers to stop once the queued tasks ran, and joins the ones that were started
+     */
+    void stopWorkers() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping.store(true);
+        }
+        m_wakeUp.notify_all();
+        for (std::unique_ptr<Worker>& worker : m_workers) {
+            if (worker->m_thread.joinable()) {
+                worker->m_thread.join();
+            }
+        }
+    }
+
+public:
+    /** Constructor for ThreadPool
+     * @param: workersCount - number of worker threads, the number of cores by default
+     */
+    explicit ThreadPool(int workersCount = static_cast<int>(std::thread::hardware_concurrency())) :
+            m_workers(), m_injected(), m_injectedCount(0), m_mutex(), m_wakeUp(), m_queuedTasks(0), m_sleepers(0),
+            m_stopping(false) {
+        if (workersCount <= 0) {
+            workersCount = 1;
+        }
+        for (int i = 0; i < workersCount; ++i) {
+            m_workers.push_back(std::unique_ptr<Worker>(new Worker()));
+        }
+        try {
+            for (int i = 0; i < workersCount; ++i) {
+                m_workers[i]->m_thread = std::thread(&ThreadPool::workerLoop, this, i);
+            }
+        }
+        catch (...) {
+            // The workers that did start must not outlive the pool, or their threads terminate the program
+            stopWorkers();
+            throw;
+        }
+    }
+
+    ThreadPool(const ThreadPool& other) = delete;
+    ThreadPool& operator=(const ThreadPool& other) = delete;
+
+    /** Destructor for ThreadPool, runs the tasks that are still queued and joins the workers */
+    ~ThreadPool() {
+        stopWorkers();
+    }
+
+    /**
+     * @param: task to run on one of the workers
+     * @note: from a worker of this pool the task goes to its own deque, otherwise to the injection queue
+     */
+    void submit(Task task) {
+        // Owned here until it is queued, so a failed push does not leak it
+        std::unique_ptr<Task> queued(new Task(std::move(task)));
+        WorkerIdentity& identity = currentWorker();
+        if (identity.m_pool == this) {
+            m_workers[identity.m_index]->m_deque.pushBottom(queued.get());
+        }
+        else {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_injected.pushBack(queued.get());
+            m_injectedCount.fetch_add(1);
+        }
+        queued.release();
+        announceTask();
+    }
+
+    /**
+     * @description: runs one queued task on the calling thread, if there is one
+     * @return: true if a task was run
+     */
+    bool runOneTask() {
+        WorkerIdentity& identity = currentWorker();
+        Task* task = findTask(identity.m_pool == this ? identity.m_index : -1);
+        if (task == nullptr) {
+            return false;
+        }
+        run(task);
+        return true;
+    }
+
+    /**
+     * @description: fork/join loop, calls body(first, last) on disjoint subranges that together cover [begin, end)
+     * @param: grain - the longest subrange that is not split further
+     * @note: the calling thread runs tasks of the pool until the whole range is done
+     */
+    void parallelFor(int begin, int end, int grain, const std::function<void(int, int)>& body) {
+        if (begin >= end) {
+            return;
+        }
+        if (grain < 1) {
+            grain = 1;
+        }
+        std::shared_ptr<std::atomic<int>> pending(new std::atomic<int>(1));
+        splitRange(*this, begin, end, grain, body, pending);
+        while (pending->load() > 0) {
+            if (!runOneTask()) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    /**
+     * @return number of worker threads
+     */
+    int size() const {
+        return static_cast<int>(m_workers.size());
+    }
+};
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,185 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "catch.hpp"
+#include "relativeIncludes.h"
+
+TEST_CASE("WorkStealingDeque Basics")
+{
+    SECTION("Owner pops newest first, thieves steal oldest first")
+    {
+        WorkStealingDeque<int> deque;
+        int out = -1;
+        REQUIRE_FALSE(deque.popBottom(out));
+        REQUIRE_FALSE(deque.steal(out));
+
+        for (int i = 0; i < 200; ++i) // Grows past the initial buffer
+        {
+            deque.pushBottom(i);
+        }
+        REQUIRE(deque.size() == 200);
+        REQUIRE(deque.popBottom(out));
+        REQUIRE(out == 199);
+        REQUIRE(deque.steal(out));
+        REQUIRE(out == 0);
+        REQUIRE(deque.steal(out));
+        REQUIRE(out == 1);
+        REQUIRE(deque.size() == 197);
+
+        for (int i = 198; i >= 2; --i)
+        {
+            REQUIRE(deque.popBottom(out));
+            REQUIRE(out == i);
+        }
+        REQUIRE_FALSE(deque.popBottom(out));
+        REQUIRE_FALSE(deque.steal(out));
+        REQUIRE(deque.size() == 0);
+    }
+
+    SECTION("Every item is taken exactly once")
+    {
+        const int itemsCount = 100000;
+        const int thievesCount = 3;
+        WorkStealingDeque<int> deque;
+        std::vector<int> taken(itemsCount, 0);
+        std::atomic<bool> done(false);
+        std::vector<std::thread> thieves;
+        std::vector<std::vector<int>> stolen(thievesCount);
+        for (int t = 0; t < thievesCount; ++t)
+        {
+            thieves.emplace_back([&deque, &done, &stolen, t]()
+            {
+                int out = 0;
+                while (!done.load() || deque.size() > 0)
+                {
+                    if (deque.steal(out))
+                    {
+                        stolen[t].push_back(out);
+                    }
+                }
+            });
+        }
+        std::vector<int> popped;
+        int out = 0;
+        for (int i = 0; i < itemsCount; ++i)
+        {
+            deque.pushBottom(i);
+            if (i % 3 == 0 && deque.popBottom(out))
+            {
+                popped.push_back(out);
+            }
+        }
+        while (deque.popBottom(out))
+        {
+            popped.push_back(out);
+        }
+        done.store(true);
+        for (std::thread& thief : thieves)
+        {
+            thief.join();
+        }
+        for (int item : popped)
+        {
+            ++taken[item];
+        }
+        for (const std::vector<int>& items : stolen)
+        {
+            for (int item : items)
+            {
+                ++taken[item];
+            }
+        }
+        bool exactlyOnce = true;
+        for (int count : taken)
+        {
+            exactlyOnce = exactlyOnce && (count == 1);
+        }
+        REQUIRE(exactlyOnce);
+    }
+}
+
+TEST_CASE("ThreadPool Basics")
+{
+    SECTION("Submitted tasks all run")
+    {
+        std::atomic<int> counter(0);
+        {
+            ThreadPool pool(3);
+            REQUIRE(pool.size() == 3);
+            for (int i = 0; i < 1000; ++i)
+            {
+                pool.submit([&counter]()
+                {
+                    counter.fetch_add(1);
+                });
+            }
+        } // The destructor runs what is still queued
+        REQUIRE(counter.load() == 1000);
+    }
+
+    SECTION("parallelFor covers the range exactly once")
+    {
+        ThreadPool pool(4);
+        const int itemsCount = 100000;
+        std::vector<int> visits(itemsCount, 0);
+        pool.parallelFor(0, itemsCount, 1000, [&visits](int first, int last)
+        {
+            for (int i = first; i < last; ++i)
+            {
+                ++visits[i];
+            }
+        });
+        bool exactlyOnce = true;
+        for (int count : visits)
+        {
+            exactlyOnce = exactlyOnce && (count == 1);
+        }
+        REQUIRE(exactlyOnce);
+
+        // Nested loops run from inside the workers
+        std::atomic<int> sum(0);
+        pool.parallelFor(0, 8, 1, [&pool, &sum](int first, int last)
+        {
+            for (int i = first; i < last; ++i)
+            {
+                pool.parallelFor(0, 100, 10, [&sum](int innerFirst, int innerLast)
+                {
+                    sum.fetch_add(innerLast - innerFirst);
+                });
+            }
+        });
+        REQUIRE(sum.load() == 800);
+
+        pool.parallelFor(5, 5, 1, [&sum](int, int)
+        {
+            sum.store(-1);
+        });
+        REQUIRE(sum.load() == 800);
+    }
+
+    SECTION("Queue transform on the pool")
+    {
+        ThreadPool pool(2);
+        Queue<int> q;
+        for (int i = 0; i < 1984; ++i)
+        {
+            q.pushBack(i);
+        }
+        std::vector<int*> items;
+        for (int& item : q)
+        {
+            items.push_back(&item);
+        }
+        pool.parallelFor(0, static_cast<int>(items.size()), 64, [&items](int first, int last)
+        {
+            for (int i = first; i < last; ++i)
+            {
+                setSixtyNine(*items[i]);
+            }
+        });
+        for (int item : q)
+        {
+            REQUIRE(item == 69);
+        }
+    }
+}
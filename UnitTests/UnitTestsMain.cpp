@@ -2,4 +2,16 @@
 
 
 #include "QueueUnitTests.cpp"
+#include "UnrolledQueueUnitTests.cpp"
+#include "ArrayQueueUnitTests.cpp"
+#include "SpscQueueUnitTests.cpp"
+#include "ConcurrentQueueUnitTests.cpp"
+#include "BlockingQueueUnitTests.cpp"
+#include "ThreadPoolUnitTests.cpp"
+#include "ParallelQueueUnitTests.cpp"
+#include "QueueViewsUnitTests.cpp"
+#include "CowQueueUnitTests.cpp"
+#include "PersistentQueueUnitTests.cpp"
+#include "IntrusiveQueueUnitTests.cpp"
+#include "SmallQueueUnitTests.cpp"
 #include "HealthPointsUnitTests.cpp"
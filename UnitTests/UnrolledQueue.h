@@ -0,0 +1,459 @@
+#ifndef UNROLLED_QUEUE_H
+#define UNROLLED_QUEUE_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "SpanKernels.h"
+
+static const int DEFAULT_BLOCK_SIZE = 64;
+
+/**
+ * @brief: UnrolledQueue class, a queue with the same interface as Queue, whose nodes hold a block of items each
+ * @tparam T: type of the items in the queue
+ * @tparam BlockSize: number of items stored contiguously in every node
+ *
+ * @note: items are pushed at the end offset of the last block and popped from the begin offset of the first block,
+ *        so iterating streams through contiguous memory and the allocator is used once per block
+ */
+template<class T, int BlockSize = DEFAULT_BLOCK_SIZE>
+class UnrolledQueue {
+    static_assert(BlockSize > 0, "UnrolledQueue needs at least one item per block");
+
+private:
+    class Block {
+    private:
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type m_items[BlockSize];
+        int m_begin;
+        int m_end;
+        Block* m_next;
+
+    public:
+        /**
+         * @description: Constructor for Block, the block starts without items
+         */
+        Block() : m_begin(0), m_end(0), m_next(nullptr) {}
+
+        /** Blocks own their items and are only linked by the queue, so they are never copied */
+        Block(const Block &other) = delete;
+        Block& operator=(const Block &other) = delete;
+
+        /**
+         * @description: Destructor for Block, destroys the items between the begin and end offsets
+         */
+        ~Block() {
+            for (int i = m_begin; i < m_end; ++i) {
+                getReferenceToItem(i).~T();
+            }
+        }
+
+        /** Getters */
+
+        T& getReferenceToItem(int index) {
+            return *reinterpret_cast<T*>(&m_items[index]);
+        }
+
+        const T& getReferenceToItem(int index) const {
+            return *reinterpret_cast<const T*>(&m_items[index]);
+        }
+
+        int getBegin() const {
+            return m_begin;
+        }
+
+        int getEnd() const {
+            return m_end;
+        }
+
+        bool isFull() const {
+            return m_end == BlockSize;
+        }
+
+        Block* getPointerToNext() const {
+            return m_next;
+        }
+
+        /** Setters */
+        Block& setPointerToNext(Block *next) {
+            m_next = next;
+            return *this;
+        }
+
+        /**
+         * @description: constructs a new item at the end offset of the block
+         * @param: arguments forwarded to the constructor of the item
+         * @note: the block must not be full, if the construction throws the block is unchanged
+         */
+        template<class... Args>
+        void emplaceBack(Args&&... args) {
+            new (&m_items[m_end]) T(std::forward<Args>(args)...);
+            m_end++;
+        }
+
+        /**
+         * @description: destroys the item at the begin offset of the block
+         * @note: when the last item is destroyed the offsets go back to the start of the block, so it can be refilled
+         */
+        void popFront() {
+            getReferenceToItem(m_begin).~T();
+            m_begin++;
+            if (m_begin == m_end) {
+                m_begin = 0;
+                m_end = 0;
+            }
+        }
+    };
+
+    Block *m_head;
+    Block *m_tail;
+    std::size_t m_size;
+
+    /**
+     * @description: constructs a new item after the last item of the queue, adding a block if the last one is full
+     * @param: arguments forwarded to the constructor of the item
+     * @note: if the allocation or the construction throws, the queue is left unchanged
+     */
+    template<class... Args>
+    void emplaceItem(Args&&... args) {
+        if (m_tail != nullptr && !m_tail->isFull()) {
+            m_tail->emplaceBack(std::forward<Args>(args)...);
+            m_size++;
+            return;
+        }
+        Block* newBlock = new Block();
+        try {
+            newBlock->emplaceBack(std::forward<Args>(args)...);
+        }
+        catch (...) {
+            delete newBlock;
+            throw;
+        }
+        if (m_tail == nullptr) {
+            m_head = newBlock;
+        }
+        else {
+            m_tail->setPointerToNext(newBlock);
+        }
+        m_tail = newBlock;
+        m_size++;
+    }
+
+    /**
+     * @description: deletes all the blocks of the queue, leaving it empty
+     */
+    void clear() {
+        while (m_head != nullptr) {
+            Block* next = m_head->getPointerToNext();
+            delete m_head;
+            m_head = next;
+        }
+        m_tail = nullptr;
+        m_size = 0;
+    }
+
+public:
+    /** Exceptions*/
+    class EmptyQueue {};
+
+    /** Constructor for UnrolledQueue */
+    UnrolledQueue() : m_head(nullptr), m_tail(nullptr), m_size(0) {}
+
+    /** Copy constructor for UnrolledQueue
+     * @param: other queue to copy
+     *
+     * @return: A new queue with the same items as the "other" queue, independent of the "other" queue
+     */
+    UnrolledQueue(const UnrolledQueue& other) : m_head(nullptr), m_tail(nullptr), m_size(0) {
+        try {
+            for (ConstIterator it = other.begin(); it != other.end(); ++it) {
+                pushBack(*it);
+            }
+        }
+        catch (...) {
+            clear();
+            throw;
+        }
+    }
+
+    /** Move constructor for UnrolledQueue
+     * @param: other queue to move from, it is left empty
+     */
+    UnrolledQueue(UnrolledQueue&& other) noexcept : m_head(other.m_head), m_tail(other.m_tail), m_size(other.m_size) {
+        other.m_head = nullptr;
+        other.m_tail = nullptr;
+        other.m_size = 0;
+    }
+
+    /** Assignment operator for UnrolledQueue
+     * @param: other queue to copy
+     *
+     * @constraints: In case of alloc fail ,need to throw std::bad_alloc and leave the original queue unchanged
+     * @explain: The copy is built on the side and exchanged with the original queue only if it succeeded.
+     *
+     * @return: Reference to the queue, with the same items as the "other" queue
+     */
+    UnrolledQueue& operator=(const UnrolledQueue& other) {
+        if (this != &other) {
+            UnrolledQueue copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    /** Move assignment operator for UnrolledQueue
+     * @param: other queue to move from, it is left empty
+     */
+    UnrolledQueue& operator=(UnrolledQueue&& other) noexcept {
+        if (this != &other) {
+            UnrolledQueue temporary(std::move(other));
+            swap(temporary);
+        }
+        return *this;
+    }
+
+    /** swap function
+     * @param: other queue to exchange contents with, in O(1)
+     */
+    void swap(UnrolledQueue& other) noexcept {
+        std::swap(m_head, other.m_head);
+        std::swap(m_tail, other.m_tail);
+        std::swap(m_size, other.m_size);
+    }
+
+    /** Destructor for UnrolledQueue */
+    ~UnrolledQueue() {
+        clear();
+    }
+
+    class ConstIterator {
+    private:
+        Block const* m_block;
+        int m_index;
+
+    public:
+        /** Constructor for ConstIterator, pointing to the first item of the block (or to the end for nullptr) */
+        explicit ConstIterator(Block const* block) : m_block(block), m_index(block == nullptr ? 0 : block->getBegin()) {}
+
+        /**Exception for invalid operation*/
+        class InvalidOperation {};
+
+        /**
+         * @brief: dereference operator for ConstIterator
+         * @return: const reference to the item
+         */
+        const T& operator*() const {
+            if (m_block == nullptr) {
+                throw InvalidOperation();
+            }
+            return m_block->getReferenceToItem(m_index);
+        }
+
+        /** Operator implementations */
+        ConstIterator& operator++() {
+            if (m_block == nullptr) {
+                throw InvalidOperation();
+            }
+            if (++m_index == m_block->getEnd()) {
+                *this = ConstIterator(m_block->getPointerToNext());
+            }
+            return *this;
+        }
+
+        bool operator==(const ConstIterator &other) const {
+            return m_block == other.m_block && m_index == other.m_index;
+        }
+
+        bool operator!=(const ConstIterator &other) const {
+            return !(*this == other);
+        }
+    };
+
+    class Iterator {
+    private:
+        Block* m_block;
+        int m_index;
+
+    public:
+        /** Constructor for Iterator, pointing to the first item of the block (or to the end for nullptr) */
+        explicit Iterator(Block* block) : m_block(block), m_index(block == nullptr ? 0 : block->getBegin()) {}
+
+        /**Exception for invalid operation*/
+        class InvalidOperation {};
+
+        /**
+         * @brief: dereference operator for Iterator
+         * @return: reference to the item
+         */
+        T& operator*() {
+            if (m_block == nullptr) {
+                throw InvalidOperation();
+            }
+            return m_block->getReferenceToItem(m_index);
+        }
+
+        /** Operator implementations */
+        Iterator& operator++() {
+            if (m_block == nullptr) {
+                throw InvalidOperation();
+            }
+            if (++m_index == m_block->getEnd()) {
+                *this = Iterator(m_block->getPointerToNext());
+            }
+            return *this;
+        }
+
+        bool operator==(const Iterator &other) const {
+            return m_block == other.m_block && m_index == other.m_index;
+        }
+
+        bool operator!=(const Iterator &other) const {
+            return !(*this == other);
+        }
+    };
+
+    /** begin() functions, an empty queue may still keep its drained block, which is skipped */
+    Iterator begin() {
+        return Iterator(m_size == 0 ? nullptr : m_head);
+    }
+
+    ConstIterator begin() const {
+        return ConstIterator(m_size == 0 ? nullptr : m_head);
+    }
+
+    Iterator end() {
+        return Iterator(nullptr);
+    }
+
+    ConstIterator end() const {
+        return ConstIterator(nullptr);
+    }
+
+    /** pushBack function
+     * @param: item to insert to the queue, it is copied
+     *
+     * @return reference to the queue, so we can concatenate functions
+     */
+    UnrolledQueue& pushBack(const T& toInsert) {
+        emplaceItem(toInsert);
+        return *this;
+    }
+
+    /** pushBack function for temporaries
+     * @param: item to move into the queue
+     *
+     * @return reference to the queue, so we can concatenate functions
+     */
+    UnrolledQueue& pushBack(T&& toInsert) {
+        emplaceItem(std::move(toInsert));
+        return *this;
+    }
+
+    /** emplaceBack function
+     * @param: arguments forwarded to the constructor of the new item, which is built inside its block
+     *
+     * @return reference to the queue, so we can concatenate functions
+     */
+    template<class... Args>
+    UnrolledQueue& emplaceBack(Args&&... args) {
+        emplaceItem(std::forward<Args>(args)...);
+        return *this;
+    }
+
+    /** front function
+     * @return reference to first element of the queue
+     */
+    const T& front() const {
+        if (m_size == 0) {
+            throw EmptyQueue();
+        }
+        return m_head->getReferenceToItem(m_head->getBegin());
+    }
+
+    T& front() {
+        if (m_size == 0) {
+            throw EmptyQueue();
+        }
+        return m_head->getReferenceToItem(m_head->getBegin());
+    }
+
+    /**
+     * @description: removes the first element of the queue
+     * @note: a drained block is freed, unless it is the only block, which is kept to be refilled
+     */
+    void popFront() {
+        if (m_size == 0) {
+            throw EmptyQueue();
+        }
+        m_head->popFront();
+        m_size--;
+        if (m_head->getEnd() == 0 && m_head != m_tail) {
+            Block* drained = m_head;
+            m_head = m_head->getPointerToNext();
+            delete drained;
+        }
+    }
+
+    /**
+     * @param: destination the first element is moved into
+     * @note: if the move throws, the queue is left unchanged
+     */
+    void popFront(T& destination) {
+        if (m_size == 0) {
+            throw EmptyQueue();
+        }
+        destination = std::move(front());
+        popFront();
+    }
+
+    /**
+     * @description: calls function(first, last) on the items of every block, in order
+     * @note: the items of a block are contiguous, so the function may treat first and last as plain array bounds
+     */
+    template<class FUNC>
+    void forEachSpan(FUNC function) {
+        for (Block* block = m_head; block != nullptr; block = block->getPointerToNext()) {
+            if (block->getBegin() != block->getEnd()) {
+                T* first = &block->getReferenceToItem(block->getBegin());
+                function(first, first + (block->getEnd() - block->getBegin()));
+            }
+        }
+    }
+
+    template<class FUNC>
+    void forEachSpan(FUNC function) const {
+        for (const Block* block = m_head; block != nullptr; block = block->getPointerToNext()) {
+            if (block->getBegin() != block->getEnd()) {
+                const T* first = &block->getReferenceToItem(block->getBegin());
+                function(first, first + (block->getEnd() - block->getBegin()));
+            }
+        }
+    }
+
+    /**
+     * @return number of elements in the queue
+     */
+    std::size_t size() const {
+        return m_size;
+    }
+};
+
+template<typename T, int BlockSize, typename FUNC>
+UnrolledQueue<T, BlockSize> filter(const UnrolledQueue<T, BlockSize>& queueToFilter, FUNC filterFunction) {
+    UnrolledQueue<T, BlockSize> newFilteredQueue;
+    typedef FilterKernel<FUNC, UnrolledQueue<T, BlockSize>> Kernel;
+    queueToFilter.forEachSpan(Kernel{filterFunction, &newFilteredQueue});
+    return newFilteredQueue;
+}
+
+template<class T, int BlockSize>
+void swap(UnrolledQueue<T, BlockSize>& first, UnrolledQueue<T, BlockSize>& second) noexcept {
+    first.swap(second);
+}
+
+template<typename T, int BlockSize, typename FUNC>
+void transform(UnrolledQueue<T, BlockSize>& queueToTransform, FUNC transformFunction) {
+    queueToTransform.forEachSpan(TransformKernel<FUNC>{transformFunction});
+}
+
+#endif // UNROLLED_QUEUE_H
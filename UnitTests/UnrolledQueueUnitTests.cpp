@@ -0,0 +1,167 @@
+#include <string>
+#include <sstream>
+#include <vector>
+#include "catch.hpp"
+#include "relativeIncludes.h"
+
+// Small blocks, so that the tests cross block boundaries all the time
+typedef UnrolledQueue<int, 4> SmallBlocksQueue;
+
+template <class T, int BlockSize>
+void readQueue(std::string& string, UnrolledQueue<T, BlockSize> &q)
+{
+    std::stringstream ss;
+
+    bool first = true;
+    ss << "{" ;
+    for (T& data : q)
+    {
+        ss << (first ? "" : ", ") << data;
+        first = false;
+    }
+    ss << "}";
+    string = ss.str();
+}
+
+// Blocks of one item, blocks the scenario crosses all the time and the default blocks
+TEMPLATE_TEST_CASE("UnrolledQueue int Queue", "[basics]", (UnrolledQueue<int, 1>), (UnrolledQueue<int, 4>),
+                   UnrolledQueue<int>)
+{
+    checkIntQueueScenario<TestType>();
+}
+
+TEST_CASE("UnrolledQueue Basics")
+{
+    SECTION("Interleaved push and pop")
+    {
+        SmallBlocksQueue q;
+        std::string result;
+        for (int i = 0; i < 6; ++i)
+        {
+            q.pushBack(i);
+        }
+        q.popFront();
+        q.popFront();
+        q.popFront();
+        q.pushBack(6);
+        readQueue(result, q);
+        REQUIRE(result == "{3, 4, 5, 6}");
+
+        q.popFront();
+        q.popFront();
+        q.pushBack(7).pushBack(8);
+        readQueue(result, q);
+        REQUIRE(result == "{5, 6, 7, 8}");
+
+        SmallBlocksQueue moved(std::move(q));
+        REQUIRE(q.size() == 0);
+        REQUIRE(q.begin() == q.end());
+        readQueue(result, moved);
+        REQUIRE(result == "{5, 6, 7, 8}");
+
+        int out = 0;
+        moved.popFront(out);
+        REQUIRE(out == 5);
+        REQUIRE(moved.size() == 3);
+    }
+
+    SECTION("Bad Allocs")
+    {
+        typedef UnrolledQueue<ControlledAllocer, 4> ControlledQueue;
+        ControlledAllocer::allowedAllocs = 1000;
+
+        ControlledQueue q1, q2;
+        ControlledAllocer c;
+        for (int i = 0; i < 10; i++)
+        {
+            q1.pushBack(c);
+        }
+
+        ControlledAllocer::allowedAllocs = 0;
+        REQUIRE_THROWS_AS(q1.pushBack(c), std::bad_alloc);
+        REQUIRE_THROWS_AS(q2.pushBack(c), std::bad_alloc);
+        REQUIRE(q1.size() == 10);
+        REQUIRE(q2.size() == 0);
+
+        q1.front().someInteger = 666;
+        ControlledAllocer::allowedAllocs = 1000;
+        ControlledQueue shortQ;
+        for (int i = 0; i < 5; i++)
+        {
+            shortQ.pushBack(c);
+        }
+
+        ControlledAllocer::allowedAllocs = 2;
+        REQUIRE_THROWS_AS(q1 = shortQ, std::bad_alloc);
+        REQUIRE(q1.size() == 10);
+        REQUIRE(q1.front().someInteger == 666);
+
+        ControlledAllocer::allowedAllocs = 5;
+        REQUIRE_THROWS_AS(ControlledQueue(q1), std::bad_alloc);
+
+        int counter = 0;
+        for (ControlledAllocer& data: q1){
+            data.someInteger = 1;
+            ++counter;
+        }
+        REQUIRE(counter == 10);
+    }
+
+    SECTION("HealthPoints")
+    {
+        UnrolledQueue<HealthPoints, 3> healthyQ;
+        for (int i = 1; i < 10; ++i)
+        {
+            healthyQ.pushBack(i);
+        }
+        auto isGreaterThen7 = [](const HealthPoints &hp)
+        {
+            return hp > 7;
+        };
+        UnrolledQueue<HealthPoints, 3> filterHealthQ = filter(healthyQ, isGreaterThen7);
+        std::string result;
+        readQueue(result, filterHealthQ);
+        REQUIRE(result == "{8(8), 9(9)}");
+
+        auto remove2HP = [](HealthPoints &hp)
+        {
+            hp -= 2;
+        };
+        transform(healthyQ, remove2HP);
+        healthyQ.popFront();
+        readQueue(result, healthyQ);
+        REQUIRE(result == "{0(2), 1(3), 2(4), 3(5), 4(6), 5(7), 6(8), 7(9)}");
+    }
+
+    SECTION("filter and transform over partial blocks")
+    {
+        SmallBlocksQueue q;
+        for (int i = 0; i < 1984; i++){
+            q.pushBack(i);
+        }
+        // The first block now starts in its middle
+        q.popFront();
+        q.popFront();
+
+        std::vector<int> expected;
+        for (int n : q){
+            if (isPrime(n)){
+                expected.push_back(n);
+            }
+        }
+        SmallBlocksQueue primesQ = filter(q, isPrime);
+        std::vector<int> filtered;
+        for (int n : primesQ){
+            filtered.push_back(n);
+        }
+        REQUIRE(filtered == expected);
+
+        // The function is not copied between the blocks, so its state carries over
+        int counter = 0;
+        transform(q, [counter](int& n) mutable { n = counter++; });
+        for (int i = 0; i < 1982; i++){
+            REQUIRE(q.front() == i);
+            q.popFront();
+        }
+    }
+}
@@ -0,0 +1,171 @@
+#ifndef WORK_STEALING_DEQUE_H
+#define WORK_STEALING_DEQUE_H
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "CacheLine.h"
+
+static const std::int64_t INITIAL_DEQUE_CAPACITY = 64;
+
+/**
+ * @brief: WorkStealingDeque class, the Chase-Lev deque. Its owner thread pushes and pops at the bottom while any
+ *         other thread may steal from the top, without locks.
+ * @tparam T: type of the items, must be trivially copyable since the items are read and written atomically
+ *
+ * @note: pushBottom/popBottom may only be called by the owner, steal by any thread
+ * @note: when the buffer grows, the old buffer is kept until the deque is destroyed, since a thief may still
+ *        read from it
+ */
+template<class T>
+class WorkStealingDeque {
+    static_assert(std::is_trivially_copyable<T>::value, "WorkStealingDeque items must be trivially copyable");
+
+private:
+    class Buffer {
+    private:
+        std::int64_t m_capacity;
+        std::atomic<T>* m_items;
+
+    public:
+        explicit Buffer(std::int64_t capacity) : m_capacity(capacity), m_items(new std::atomic<T>[capacity]) {}
+
+        Buffer(const Buffer& other) = delete;
+        Buffer& operator=(const Buffer& other) = delete;
+
+        ~Buffer() {
+            delete[] m_items;
+        }
+
+        std::int64_t capacity() const {
+            return m_capacity;
+        }
+
+        T get(std::int64_t index) const {
+            return m_items[index & (m_capacity - 1)].load(std::memory_order_relaxed);
+        }
+
+        void put(std::int64_t index, T item) {
+            m_items[index & (m_capacity - 1)].store(item, std::memory_order_relaxed);
+        }
+
+        /**
+         * @return: a buffer twice as big, holding the items between top and bottom
+         */
+        Buffer* grow(std::int64_t top, std::int64_t bottom) const {
+            Buffer* bigger = new Buffer(m_capacity * 2);
+            for (std::int64_t i = top; i < bottom; ++i) {
+                bigger->put(i, get(i));
+            }
+            return bigger;
+        }
+    };
+
+    alignas(CACHE_LINE_SIZE) std::atomic<std::int64_t> m_top;
+    alignas(CACHE_LINE_SIZE) std::atomic<std::int64_t> m_bottom;
+    std::atomic<Buffer*> m_buffer;
+    std::vector<Buffer*> m_oldBuffers;
+
+public:
+    /** Constructor for WorkStealingDeque */
+    WorkStealingDeque() : m_top(0), m_bottom(0), m_buffer(new Buffer(INITIAL_DEQUE_CAPACITY)), m_oldBuffers() {}
+
+    /** The deque is shared by threads through its address, so it is never copied or moved */
+    WorkStealingDeque(const WorkStealingDeque& other) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque& other) = delete;
+
+    /** Destructor for WorkStealingDeque, must not run while another thread still uses the deque */
+    ~WorkStealingDeque() {
+        delete m_buffer.load();
+        for (Buffer* buffer : m_oldBuffers) {
+            delete buffer;
+        }
+    }
+
+    /**
+     * @param: item to push at the bottom of the deque
+     * @note: owner only
+     */
+    void pushBottom(T item) {
+        std::int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        std::int64_t top = m_top.load(std::memory_order_acquire);
+        Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+        if (bottom - top > buffer->capacity() - 1) {
+            // The old buffer is kept for the thieves that may still read it, it is only listed once the bigger one
+            // exists, so a failed growth leaves the deque as it was
+            Buffer* bigger = buffer->grow(top, bottom);
+            try {
+                m_oldBuffers.push_back(buffer);
+            }
+            catch (...) {
+                delete bigger;
+                throw;
+            }
+            buffer = bigger;
+            m_buffer.store(buffer, std::memory_order_release);
+        }
+        buffer->put(bottom, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @param: destination the bottom item is written to
+     * @note: owner only, the last item is raced for against the thieves
+     *
+     * @return true if an item was popped, false if the deque was empty
+     */
+    bool popBottom(T& destination) {
+        std::int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+        m_bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t top = m_top.load(std::memory_order_relaxed);
+        if (top > bottom) {
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+        destination = buffer->get(bottom);
+        if (top == bottom) {
+            bool won = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                     std::memory_order_relaxed);
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    /**
+     * @param: destination the top item is written to
+     * @note: any thread
+     *
+     * @return true if an item was stolen, false if the deque was empty or another thread took the item first
+     */
+    bool steal(T& destination) {
+        std::int64_t top = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t bottom = m_bottom.load(std::memory_order_acquire);
+        if (top >= bottom) {
+            return false;
+        }
+        Buffer* buffer = m_buffer.load(std::memory_order_acquire);
+        T item = buffer->get(top);
+        if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return false;
+        }
+        destination = item;
+        return true;
+    }
+
+    /**
+     * @return number of items in the deque, only a snapshot while other threads use it
+     */
+    std::int64_t size() const {
+        std::int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        std::int64_t top = m_top.load(std::memory_order_relaxed);
+        return bottom > top ? bottom - top : 0;
+    }
+};
+
+#endif // WORK_STEALING_DEQUE_H
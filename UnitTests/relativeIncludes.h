@@ -3,5 +3,19 @@
 
 #include "HealthPoints.h"
 #include "Queue.h"
+#include "PoolAllocator.h"
+#include "UnrolledQueue.h"
+#include "ArrayQueue.h"
+#include "SpscQueue.h"
+#include "ConcurrentQueue.h"
+#include "BlockingQueue.h"
+#include "WorkStealingDeque.h"
+#include "ThreadPool.h"
+#include "ParallelQueue.h"
+#include "QueueViews.h"
+#include "CowQueue.h"
+#include "PersistentQueue.h"
+#include "IntrusiveQueue.h"
+#include "SmallQueue.h"
 
 #endif // RELATIVE_INCLUDES_EXE3_TESTS
\ No newline at end of file